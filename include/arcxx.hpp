@@ -19,4 +19,6 @@
 #if __has_include(<libpq-fe.h>)
 #include "arcxx/connectors/postgresql_connector.hpp"
 #endif
+
+#include "arcxx/connectors/connection_pool.hpp"
 //#endif
\ No newline at end of file
@@ -31,6 +31,22 @@ namespace arcxx {
     template<typename T>
     concept is_attribute_aggregator = std::derived_from<T, attribute_aggregator<typename T::model_type, typename T::attribute_type, typename T::aggregator_type>>;
 
+    namespace detail {
+        // getters for detail::constant_string_getter
+        template<typename T>
+        struct table_name_getter {
+            constexpr decltype(auto) operator()() const noexcept { return T::table_name; }
+        };
+        template<typename T>
+        struct column_name_getter {
+            constexpr decltype(auto) operator()() const noexcept { return T::column_name; }
+        };
+        template<typename T>
+        struct aggregation_func_getter {
+            constexpr decltype(auto) operator()() const noexcept { return T::aggregation_func; }
+        };
+    }
+
     template<is_connector Connector, is_attribute Attr>
     requires false
     [[nodiscard]] arcxx::string to_string(const Attr& attr, arcxx::string&& buff = {});
@@ -42,8 +58,15 @@ namespace arcxx {
 
 template<arcxx::is_attribute Attr>
 struct std::hash<Attr> {
-    std::hash<std::optional<typename Attr::value_type>> inner_hash;
+    // strings are hashed as string_view, since std::hash is not specialized for strings of arcxx::pmr::allocator
+    using hashed_type = std::conditional_t<std::same_as<typename Attr::value_type, arcxx::string>, arcxx::string_view, typename Attr::value_type>;
+    std::hash<std::optional<hashed_type>> inner_hash;
     std::size_t operator()(const Attr& key) const {
-        return inner_hash(static_cast<std::optional<typename Attr::value_type>>(key));
+        if constexpr(std::same_as<typename Attr::value_type, arcxx::string>) {
+            return inner_hash(key ? std::optional<hashed_type>{ key.value() } : std::nullopt);
+        }
+        else {
+            return inner_hash(static_cast<std::optional<typename Attr::value_type>>(key));
+        }
     }
 };
\ No newline at end of file
@@ -18,7 +18,15 @@ namespace arcxx {
         attribute_aggregator() = delete;
 
         static constexpr auto column_full_name() {
-            return concat_strings(Aggregator::aggregation_func, "(", Attribute::column_full_name(), ")");
+            if constexpr(detail::constant_string_getter<detail::aggregation_func_getter<Aggregator>> && detail::is_string_literal<decltype(Attribute::column_full_name())>){
+                return concat_strings(
+                    to_string_literal(detail::aggregation_func_getter<Aggregator>{}).c_str(),
+                    "(", Attribute::column_full_name().c_str(), ")"
+                );
+            }
+            else {
+                return concat_strings(Aggregator::aggregation_func, "(", Attribute::column_full_name(), ")");
+            }
         }
     };
 }
\ No newline at end of file
@@ -52,7 +52,15 @@ namespace arcxx{
     }
     template<typename Model, typename Attribute, typename Type>
     inline constexpr auto attribute_common<Model, Attribute, Type>::column_full_name() {
-        return concat_strings("\"", Model::table_name, "\".\"", Attribute::column_name, "\"");
+        if constexpr(detail::constant_string_getter<detail::table_name_getter<Model>> && detail::constant_string_getter<detail::column_name_getter<Attribute>>){
+            return concat_strings(
+                "\"", to_string_literal(detail::table_name_getter<Model>{}).c_str(),
+                "\".\"", to_string_literal(detail::column_name_getter<Attribute>{}).c_str(), "\""
+            );
+        }
+        else {
+            return concat_strings("\"", Model::table_name, "\".\"", Attribute::column_name, "\"");
+        }
     }
 
     template<typename Model, typename Attribute, typename Type>
@@ -76,11 +84,12 @@ namespace arcxx{
     }
 
     namespace detail{
-        template<typename Attribute, std::size_t N>
-        inline auto make_condition(Attribute&& attr, built_in_string_literal<N> op){
+        template<typename Attribute>
+        inline auto make_condition(Attribute&& attr, const static_string_view op){
             query_condition<std::tuple<Attribute>> ret;
-            ret.condition.push_back(concat_strings(Attribute::column_full_name(), op));
-            ret.condition.push_back(static_cast<std::size_t>(0));
+            ret.condition.template push_fragment<&Attribute::column_full_name>(query_clause::conditions);
+            ret.condition.push_static(query_clause::conditions, op);
+            ret.condition.push_bind(query_clause::conditions, 0);
             ret.bind_attrs = std::make_tuple(std::move(attr));
             return ret;
         }
@@ -88,13 +97,13 @@ namespace arcxx{
         template<typename Attribute, std::size_t I, typename Condition, std::convertible_to<Attribute> Last>
         inline void copy_and_set_attrs_to_condition(Condition& ret, const Last& last) {
             std::get<I>(ret.bind_attrs) = Attribute{ last };
-            ret.condition.push_back(I);
+            ret.condition.push_bind(query_clause::conditions, I);
         }
 
         template<typename Attribute, std::size_t I, typename Condition, std::convertible_to<Attribute> Head, std::convertible_to<Attribute>... Tails>
         inline void copy_and_set_attrs_to_condition(Condition& ret, const Head& head, const Tails&... tails) {
             copy_and_set_attrs_to_condition<Attribute, I+1>(ret, head);
-            ret.condition.push_back(",");
+            ret.condition.push_static(query_clause::conditions, ",");
             copy_and_set_attrs_to_condition<Attribute, I+1>(ret, tails...);
         }
     }
@@ -103,12 +112,10 @@ namespace arcxx{
     template<std::convertible_to<Attribute>... Attrs>
     inline auto attribute_common<Model, Attribute, Type>::in(const Attrs&... values) {
         query_condition<std::tuple<decltype(values, std::declval<Attribute>())...>> ret;
-        ret.condition.push_back(concat_strings(
-            "\"", Model::table_name, "\".\"",
-            Attribute::column_name, "\" in ("
-        ));
+        ret.condition.template push_fragment<&Attribute::column_full_name>(query_clause::conditions);
+        ret.condition.push_static(query_clause::conditions, " in (");
         detail::copy_and_set_attrs_to_condition<Attribute, 0>(ret, values...);
-        ret.condition.push_back(")");
+        ret.condition.push_static(query_clause::conditions, ")");
         return ret;
     }
     template<typename Model, typename Attribute, typename Type>
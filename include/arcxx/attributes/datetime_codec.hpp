@@ -0,0 +1,147 @@
+#pragma once
+/*
+ * ARCXX: https://github.com/akisute514/arcxx
+ * Copyright (c) 2021 akisute514
+ *
+ * Released under the MIT License.
+ */
+#include "../utils.hpp"
+
+namespace arcxx::detail {
+    /*
+     * ISO 8601 text of time points of system_clock, YYYY-MM-DD[ hh:mm:ss[.fffffffff]] (UTC or GMT).
+     * It uses neither locale nor states of libc (std::gmtime, strftime and strptime), so that it is thread-safe.
+     */
+
+    // Write value as width digits padded with zeros.
+    inline char* write_digits(char* out, std::uint64_t value, const int width) noexcept {
+        for(int i = width - 1; i >= 0; --i) {
+            out[i] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        }
+        return out + width;
+    }
+    // Read width digits, or -1 if any of them is not a digit.
+    inline int read_digits(const char* const in, const int width) noexcept {
+        int value = 0;
+        bool all_digits = true;
+        for(int i = 0; i < width; ++i) {
+            const auto digit = static_cast<unsigned>(static_cast<unsigned char>(in[i])) - '0';
+            all_digits &= digit < 10;
+            value = value * 10 + static_cast<int>(digit);
+        }
+        return all_digits ? value : -1;
+    }
+
+    // Append the text of time_point to buff. Time of day is omitted if Duration is days,
+    // and fraction of second is written only if it is not zero.
+    template<typename Clock, typename Duration>
+    inline void append_datetime(arcxx::string& buff, const std::chrono::time_point<Clock, Duration> time_point) {
+        namespace chrono = std::chrono;
+        const auto days = chrono::floor<chrono::days>(time_point.time_since_epoch());
+        const chrono::year_month_day ymd{ chrono::sys_days{ days } };
+
+        // "-32767-12-31 23:59:59." and fraction
+        std::array<char, 24 + std::numeric_limits<std::uint64_t>::digits10> str;
+        char* out = str.data();
+        int year = static_cast<int>(ymd.year());
+        if(year < 0) {
+            *out++ = '-';
+            year = -year;
+        }
+        if(year <= 9999) out = write_digits(out, static_cast<std::uint64_t>(year), 4);
+        else out = std::to_chars(out, out + 5, year).ptr;
+        *out++ = '-';
+        out = write_digits(out, static_cast<unsigned>(ymd.month()), 2);
+        *out++ = '-';
+        out = write_digits(out, static_cast<unsigned>(ymd.day()), 2);
+
+        if constexpr(std::ratio_less_v<typename Duration::period, chrono::days::period>) {
+            const chrono::hh_mm_ss<Duration> time{ chrono::duration_cast<Duration>(time_point.time_since_epoch() - days) };
+            *out++ = ' ';
+            out = write_digits(out, static_cast<std::uint64_t>(time.hours().count()), 2);
+            *out++ = ':';
+            out = write_digits(out, static_cast<std::uint64_t>(time.minutes().count()), 2);
+            *out++ = ':';
+            out = write_digits(out, static_cast<std::uint64_t>(time.seconds().count()), 2);
+            if constexpr(chrono::hh_mm_ss<Duration>::fractional_width != 0) {
+                if(const auto subseconds = time.subseconds().count(); subseconds != 0) {
+                    *out++ = '.';
+                    out = write_digits(out, static_cast<std::uint64_t>(subseconds), chrono::hh_mm_ss<Duration>::fractional_width);
+                }
+            }
+        }
+        buff.append(str.data(), out);
+    }
+
+    // Parse YYYY-MM-DD[( |T)hh:mm:ss[.f...]][Z|(+|-)hh[[:]mm]]. Returns nullopt if str is not in the format.
+    // Time of day is truncated if TimePoint is days, and digits of fraction below nanoseconds are ignored.
+    template<typename TimePoint>
+    [[nodiscard]] inline std::optional<TimePoint> parse_datetime(const arcxx::string_view str) noexcept {
+        namespace chrono = std::chrono;
+        using duration = typename TimePoint::duration;
+        const char* in = str.data();
+        const char* const end = in + str.size();
+
+        int year = 0;
+        const auto [year_end, ec] = std::from_chars(in, end, year);
+        // at least 4 digits
+        if(ec != std::errc{} || year_end - in - (*in == '-') < 4) return std::nullopt;
+        in = year_end;
+        if(end - in < 6 || in[0] != '-' || in[3] != '-') return std::nullopt;
+        const int month = read_digits(in + 1, 2);
+        const int day = read_digits(in + 4, 2);
+        if(month < 0 || day < 0) return std::nullopt;
+        const chrono::year_month_day ymd{ chrono::year{ year }, chrono::month{ static_cast<unsigned>(month) }, chrono::day{ static_cast<unsigned>(day) } };
+        if(!ymd.ok()) return std::nullopt;
+        in += 6;
+
+        chrono::seconds seconds{ chrono::sys_days{ ymd }.time_since_epoch() };
+        chrono::nanoseconds fraction{ 0 };
+        if(in != end && (*in == ' ' || *in == 'T')) {
+            if(end - in < 9 || in[3] != ':' || in[6] != ':') return std::nullopt;
+            const int hh = read_digits(in + 1, 2);
+            const int mm = read_digits(in + 4, 2);
+            const int ss = read_digits(in + 7, 2);
+            // 60 is a leap second
+            if(hh < 0 || 23 < hh || mm < 0 || 59 < mm || ss < 0 || 60 < ss) return std::nullopt;
+            seconds += chrono::hours{ hh } + chrono::minutes{ mm } + chrono::seconds{ ss };
+            in += 9;
+
+            if(in != end && *in == '.') {
+                ++in;
+                const char* const digits_begin = in;
+                std::int64_t nanoseconds = 0;
+                for(; in != end && static_cast<unsigned>(static_cast<unsigned char>(*in)) - '0' < 10; ++in) {
+                    if(in - digits_begin < 9) nanoseconds = nanoseconds * 10 + (*in - '0');
+                }
+                if(in == digits_begin) return std::nullopt;
+                for(auto width = in - digits_begin; width < 9; ++width) nanoseconds *= 10;
+                fraction = chrono::nanoseconds{ nanoseconds };
+            }
+
+            if(in != end && *in == 'Z') {
+                ++in;
+            }
+            else if(in != end && (*in == '+' || *in == '-')) {
+                const int sign = *in == '-' ? -1 : 1;
+                ++in;
+                if(end - in < 2) return std::nullopt;
+                const int offset_hours = read_digits(in, 2);
+                in += 2;
+                int offset_minutes = 0;
+                if(in != end && *in == ':') ++in;
+                if(end - in >= 2) {
+                    offset_minutes = read_digits(in, 2);
+                    in += 2;
+                }
+                if(offset_hours < 0 || offset_minutes < 0) return std::nullopt;
+                seconds -= sign * (chrono::hours{ offset_hours } + chrono::minutes{ offset_minutes });
+            }
+        }
+        if(in != end) return std::nullopt;
+
+        // fraction is added after flooring, so that nanoseconds does not overflow for distant years
+        return TimePoint{ chrono::floor<duration>(seconds) + chrono::floor<duration>(fraction) };
+    }
+}
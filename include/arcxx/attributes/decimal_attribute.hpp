@@ -16,11 +16,12 @@ namespace arcxx {
         [[nodiscard]] static auto between(const ArgType1 value1, const ArgType2 value2){
             query_condition<std::tuple<Attribute, Attribute>> ret;
             ret.bind_attrs = std::make_tuple(static_cast<Attribute>(value1), static_cast<Attribute>(value2));
-            ret.condition.reserve(4);
-            ret.condition.push_back(concat_strings(Attribute::column_full_name(), " BETWEEN "));
-            ret.condition.push_back(0UL);
-            ret.condition.push_back(" AND ");
-            ret.condition.push_back(1UL);
+            ret.condition.reserve(5);
+            ret.condition.template push_fragment<&Attribute::column_full_name>(query_clause::conditions);
+            ret.condition.push_static(query_clause::conditions, " BETWEEN ");
+            ret.condition.push_bind(query_clause::conditions, 0);
+            ret.condition.push_static(query_clause::conditions, " AND ");
+            ret.condition.push_bind(query_clause::conditions, 1);
             return ret;
         }
 
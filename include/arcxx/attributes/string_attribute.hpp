@@ -36,8 +36,9 @@ namespace arcxx {
         [[nodiscard]] static constexpr query_condition<std::tuple<Attribute>> like(const StringType& value){
             query_condition<std::tuple<Attribute>> ret;
             ret.bind_attrs = std::make_tuple<Attribute>(arcxx::string{ value });
-            ret.condition.push_back(concat_strings(Attribute::column_full_name(), " LIKE "));
-            ret.condition.push_back(static_cast<std::size_t>(0));
+            ret.condition.template push_fragment<&Attribute::column_full_name>(query_clause::conditions);
+            ret.condition.push_static(query_clause::conditions, " LIKE ");
+            ret.condition.push_bind(query_clause::conditions, 0);
             return ret;
         }
     };
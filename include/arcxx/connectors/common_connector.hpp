@@ -6,6 +6,7 @@
  * Released under the MIT License.
  */
 #include "../attribute.hpp"
+#include "../attributes/datetime_codec.hpp"
 
 namespace arcxx {
     struct common_connector : public connector {
@@ -88,32 +89,11 @@ namespace arcxx {
     template<std::same_as<common_connector> Connector, is_attribute Attr>
     requires regarded_as_clock<typename Attr::value_type>
     [[nodiscard]] inline arcxx::string to_string(const Attr& attr, arcxx::string&& buff) {
-        // YYYY-MM-DD hh:mm:ss
-        using clock = Attr::value_type::clock;
-        using duration = typename Attr::value_type::duration;
-        namespace chrono = std::chrono;
-
+        // YYYY-MM-DD[ hh:mm:ss[.fffffffff]] (UTC or GMT)
         if(attr){
-            #ifdef _MSC_VER
-            using duration = typename Attr::value_type::duration;
-            if constexpr(std::is_same_v<duration, chrono::days>){
-                std::format_to(std::back_inserter(buff),"\'{:%F}\'", attr.value());
-            }
-            else {
-                std::format_to(std::back_inserter(buff), "\'{:%F %T}\'", chrono::floor<chrono::seconds>(attr.value()));
-            }
-            #else
-            const std::time_t t = clock::to_time_t(attr.value());
-            std::tm* gmt = std::gmtime(&t);
-            if(gmt == nullptr) throw std::runtime_error("std::gmtime causes error");
-            char str[32]{0};
-            const char* const fmt_str = [](){
-                if constexpr(std::is_same_v<duration, chrono::days>) return "\'%F\'";
-                else return "\'%F %T\'";
-            }();
-            if(std::strftime(str, 32, fmt_str, gmt) == 0) throw std::runtime_error("std::strftime causes error");
-            buff += str;
-            #endif
+            buff += '\'';
+            detail::append_datetime(buff, attr.value());
+            buff += '\'';
         }
         else{
             buff += "null";
@@ -123,34 +103,9 @@ namespace arcxx {
     template<std::same_as<common_connector> Connector, is_attribute Attr>
     requires regarded_as_clock<typename Attr::value_type>
     inline void from_string(Attr& attr, const arcxx::string_view str){
-        using clock = Attr::value_type::clock;
-        using duration = typename Attr::value_type::duration;
-        namespace chrono = std::chrono;
-
         if(str == "null") attr = std::nullopt;
-        else{
-            #ifdef _MSC_VER
-            chrono::time_point<clock, duration> result;
-            std::basic_istringstream<typename arcxx::string::value_type> iss{ arcxx::string{str} };
-            if constexpr((std::is_same_v<duration, chrono::days>)){
-                iss >> std::chrono::parse("%F", result);
-            }
-            else {
-                iss >> std::chrono::parse("%F %T", result);
-            }
-            if (!iss) throw std::runtime_error("unavailable clock format");
-            #else
-            std::tm gmt;
-            const char* const fmt_str = [](){
-                if constexpr(std::is_same_v<duration, chrono::days>) return "%F";
-                else return "%F %T";
-            }();
-            if(strptime(&str.front(), fmt_str, &gmt) == &str.front()) throw std::runtime_error("unavailable clock format");
-            const time_t t = timegm(&gmt);
-            if(t == time_t(-1)) throw std::runtime_error("unavailable clock format");
-            attr = clock::from_time_t(t);
-            #endif
-        }
+        else if(const auto time_point = detail::parse_datetime<typename Attr::value_type>(str)) attr = time_point.value();
+        else throw std::runtime_error("unavailable clock format");
     }
 
     // boolean
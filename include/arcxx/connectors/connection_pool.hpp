@@ -0,0 +1,244 @@
+#pragma once
+/*
+ * ARCXX: https://github.com/akisute514/arcxx
+ * Copyright (c) 2021 akisute514
+ *
+ * Released under the MIT License.
+ */
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include "../connector.hpp"
+#include "../thread_pool.hpp"
+
+namespace arcxx {
+    struct connection_pool_options {
+        // connections opened by the constructor, unless lazy
+        std::size_t min_size = 0;
+        // maximum number of connections, including checked out ones
+        std::size_t max_size = 8;
+        // If true, connections are opened by checkouts only.
+        bool lazy = false;
+        // how long checkout() waits for a returned connection when max_size connections are checked out
+        std::chrono::milliseconds checkout_timeout = std::chrono::seconds{ 30 };
+        // Returned connections are discarded if they are disconnected, and open transactions are rolled back.
+        bool validate_on_return = true;
+    };
+
+    /*
+     * Thread-safe pool of connections.
+     * A checked out connection is used by a thread at a time, and returned to the pool when its handle is destroyed.
+     * Connections are opened by Connector::open(args...), or by args if it is a callable which returns Connector.
+     * Initial connections are opened in parallel if the connector supports Connector::open_many(count, args...).
+     */
+    template<is_connector Connector>
+    class connection_pool {
+    public:
+        class handle {
+        private:
+            friend class connection_pool;
+            connection_pool* pool;
+            std::unique_ptr<Connector> conn;
+            handle(connection_pool* p, std::unique_ptr<Connector>&& c) noexcept : pool(p), conn(std::move(c)) {}
+        public:
+            handle(const handle&) = delete;
+            handle(handle&& src) noexcept : pool(src.pool), conn(std::move(src.conn)) {}
+            handle& operator=(const handle&) = delete;
+            handle& operator=(handle&& src) noexcept {
+                if(this != &src) {
+                    release();
+                    pool = src.pool;
+                    conn = std::move(src.conn);
+                }
+                return *this;
+            }
+            ~handle() { release(); }
+
+            Connector& operator*() const noexcept { return *conn; }
+            Connector* operator->() const noexcept { return conn.get(); }
+            Connector& get() const noexcept { return *conn; }
+            // Return the connection to the pool before the handle is destroyed.
+            void release() {
+                if(conn) pool->give_back(std::move(conn));
+            }
+        };
+
+    private:
+        connection_pool_options options;
+        std::function<Connector()> open_func;
+        std::function<std::vector<Connector>(std::size_t)> open_many_func;
+
+        mutable std::mutex mtx;
+        std::condition_variable returned;
+        // most recently returned last
+        std::vector<std::unique_ptr<Connector>> idle;
+        // idle and checked out connections, and connections being opened
+        std::size_t total = 0;
+
+        void give_back(std::unique_ptr<Connector>&& conn);
+        static bool validate(Connector& conn);
+    public:
+        template<typename... Args>
+        explicit connection_pool(const connection_pool_options& opts, Args&&... args);
+        connection_pool(const connection_pool&) = delete;
+        connection_pool(connection_pool&&) = delete;
+        // All handles must be destroyed before the pool.
+        ~connection_pool() = default;
+
+        // Open connections up to min_size. Returns the error of the first connection which can not be opened.
+        arcxx::expected<void, arcxx::string> warm_up();
+
+        // Take an idle connection, or open a new one if there are less than max_size connections.
+        // Otherwise wait for a connection to be returned until the timeout.
+        [[nodiscard]] arcxx::expected<handle, arcxx::string> checkout();
+        [[nodiscard]] arcxx::expected<handle, arcxx::string> checkout(const std::chrono::milliseconds timeout);
+
+        // number of connections, including checked out ones
+        std::size_t size() const;
+        std::size_t idle_size() const;
+    };
+
+    template<is_connector Connector>
+    template<typename... Args>
+    inline connection_pool<Connector>::connection_pool(const connection_pool_options& opts, Args&&... args) : options(opts) {
+        if constexpr(sizeof...(Args) == 1 && (std::is_invocable_r_v<Connector, std::remove_cvref_t<Args>&> && ...)) {
+            open_func = (std::forward<Args>(args), ...);
+        }
+        else {
+            open_func = [args...]{ return Connector::open(args...); };
+            if constexpr(requires{ Connector::open_many(std::size_t{}, args...); }) {
+                open_many_func = [args...](const std::size_t count){ return Connector::open_many(count, args...); };
+            }
+        }
+        options.max_size = std::max(options.max_size, std::size_t{ 1 });
+        options.min_size = std::min(options.min_size, options.max_size);
+        if(!options.lazy) static_cast<void>(warm_up());
+    }
+
+    template<is_connector Connector>
+    inline arcxx::expected<void, arcxx::string> connection_pool<Connector>::warm_up() {
+        std::size_t count = 0;
+        {
+            std::lock_guard lock{ mtx };
+            if(total >= options.min_size) return {};
+            count = options.min_size - total;
+            total += count;
+        }
+
+        std::vector<std::unique_ptr<Connector>> opened;
+        opened.reserve(count);
+        if(open_many_func) {
+            for(auto& conn : open_many_func(count)) opened.push_back(std::make_unique<Connector>(std::move(conn)));
+        }
+        else {
+            for(std::size_t i = 0; i < count; ++i) opened.push_back(std::make_unique<Connector>(open_func()));
+        }
+
+        std::optional<arcxx::string> error = std::nullopt;
+        {
+            std::lock_guard lock{ mtx };
+            total -= count;
+            for(auto& conn : opened) {
+                if(conn->has_error()) {
+                    if(!error) error = conn->error_message();
+                    continue;
+                }
+                idle.push_back(std::move(conn));
+                ++total;
+            }
+        }
+        returned.notify_all();
+        if(error) return arcxx::make_unexpected(error.value());
+        return {};
+    }
+
+    template<is_connector Connector>
+    inline auto connection_pool<Connector>::checkout() -> arcxx::expected<handle, arcxx::string> {
+        return checkout(options.checkout_timeout);
+    }
+
+    template<is_connector Connector>
+    inline auto connection_pool<Connector>::checkout(const std::chrono::milliseconds timeout) -> arcxx::expected<handle, arcxx::string> {
+        std::unique_lock lock{ mtx };
+        const auto available = [this]{ return !idle.empty() || total < options.max_size; };
+        if(!returned.wait_for(lock, timeout, available)) {
+            return arcxx::make_unexpected("timed out waiting for a connection of the pool");
+        }
+        if(!idle.empty()) {
+            auto conn = std::move(idle.back());
+            idle.pop_back();
+            return handle{ this, std::move(conn) };
+        }
+
+        // A new connection is opened without the lock, so that other threads take returned connections.
+        ++total;
+        lock.unlock();
+        auto conn = std::make_unique<Connector>(open_func());
+        if(conn->has_error()) {
+            auto error = conn->error_message();
+            conn.reset();
+            lock.lock();
+            --total;
+            lock.unlock();
+            returned.notify_one();
+            return arcxx::make_unexpected(std::move(error));
+        }
+        return handle{ this, std::move(conn) };
+    }
+
+    template<is_connector Connector>
+    inline void connection_pool<Connector>::give_back(std::unique_ptr<Connector>&& conn) {
+        if(options.validate_on_return && !validate(*conn)) conn.reset();
+        {
+            std::lock_guard lock{ mtx };
+            if(conn) idle.push_back(std::move(conn));
+            else --total;
+        }
+        returned.notify_one();
+    }
+
+    template<is_connector Connector>
+    inline bool connection_pool<Connector>::validate(Connector& conn) {
+        if(!conn.connected()) return false;
+        if(conn.in_transaction() && !conn.rollback()) return false;
+        // errors of the previous user are not seen by the next one
+        conn.clear_error();
+        return true;
+    }
+
+    template<is_connector Connector>
+    inline std::size_t connection_pool<Connector>::size() const {
+        std::lock_guard lock{ mtx };
+        return total;
+    }
+    template<is_connector Connector>
+    inline std::size_t connection_pool<Connector>::idle_size() const {
+        std::lock_guard lock{ mtx };
+        return idle.size();
+    }
+
+    /*
+     * Execute independent queries in parallel by connections of the pool, and return their results in order.
+     * The calling thread runs queries of the executor while waiting, so that the latency is about the slowest query.
+     */
+    template<is_connector Connector, typename... Queries>
+    requires (sizeof...(Queries) > 0) && (requires{ typename Queries::result_type; } && ...)
+    [[nodiscard]] auto exec_all(thread_pool& executor, connection_pool<Connector>& pool, const Queries&... queries) {
+        const auto exec_one = [&pool]<typename Query>(const Query& query) -> arcxx::expected<typename Query::result_type, arcxx::string> {
+            auto conn = pool.checkout();
+            if(!conn) return arcxx::make_unexpected(std::move(conn.error()));
+            return query.exec(*conn.value());
+        };
+        // queries are referred by tasks, which finish before returning
+        auto futures = std::make_tuple(executor.submit([&exec_one, &queries]{ return exec_one(queries); })...);
+        return std::apply(
+            [&executor](auto&... future){ return std::tuple{ executor.wait(future)... }; },
+            futures
+        );
+    }
+    template<is_connector Connector, typename... Queries>
+    requires (sizeof...(Queries) > 0) && (requires{ typename Queries::result_type; } && ...)
+    [[nodiscard]] auto exec_all(connection_pool<Connector>& pool, const Queries&... queries) {
+        return exec_all(thread_pool::shared(), pool, queries...);
+    }
+}
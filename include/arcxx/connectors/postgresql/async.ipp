@@ -0,0 +1,368 @@
+#pragma once
+/*
+ * ARCXX: https://github.com/akisute514/arcxx
+ * Copyright (c) 2021 akisute514
+ *
+ * Released under the MIT License.
+ */
+#ifdef ARCXX_POSTGRESQL_HAS_ASYNC
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+namespace arcxx::PostgreSQL {
+    template<typename T = void>
+    class task;
+
+    /*
+     * Minimal event loop of coroutines (epoll).
+     * Coroutines suspended by co_await query.exec_async(conn) are resumed in run() when their results are received,
+     * so that a thread keeps queries of many connections in flight.
+     */
+    class reactor {
+    public:
+        // Waiting operation on a socket, which lives until the coroutine is resumed.
+        class waiter {
+        private:
+            friend class reactor;
+            std::coroutine_handle<> handle;
+        protected:
+            int fd = -1;
+            ~waiter() = default;
+        public:
+            // Called when fd is ready. Returns events to wait for again, or 0 to resume the coroutine.
+            virtual std::uint32_t on_ready() = 0;
+        };
+
+    private:
+        int epoll_fd;
+        arcxx::detail::persistent_message error_msg = std::nullopt;
+        std::size_t waiting_count = 0;
+        std::deque<std::coroutine_handle<>> ready;
+        inline static thread_local reactor* running = nullptr;
+    public:
+        reactor();
+        reactor(const reactor&) = delete;
+        reactor(reactor&&) = delete;
+        ~reactor();
+
+        bool has_error() const noexcept;
+        const arcxx::string& error_message() const;
+
+        // reactor whose run() is running on this thread, or nullptr
+        static reactor* current() noexcept;
+
+        // Resume handle in run() when fd of w is ready for events (EPOLLIN and EPOLLOUT). Returns false if fd can not be waited for.
+        bool wait(waiter& w, const std::uint32_t events, std::coroutine_handle<> handle);
+        // Resume handle in run().
+        void post(std::coroutine_handle<> handle);
+        // Start t in run(). t must live until it is finished.
+        template<typename T>
+        void spawn(task<T>& t);
+
+        // Resume coroutines until none of them is ready or waiting.
+        arcxx::expected<void, arcxx::string> run();
+        // number of waiting coroutines
+        std::size_t waiting() const noexcept;
+    };
+
+    namespace detail {
+        template<typename T>
+        struct task_value {
+            std::optional<T> value;
+            void return_value(T v) { value.emplace(std::move(v)); }
+            T& get() { return value.value(); }
+            T take() { return std::move(value.value()); }
+        };
+        template<>
+        struct task_value<void> {
+            void return_void() noexcept {}
+            void get() const noexcept {}
+            void take() const noexcept {}
+        };
+    }
+
+    /*
+     * Coroutine which starts when it is awaited or spawned on a reactor.
+     * Awaiting coroutine is resumed when the task is finished.
+     */
+    template<typename T>
+    class task {
+    public:
+        struct promise_type : public detail::task_value<T> {
+            std::coroutine_handle<> continuation = nullptr;
+            std::exception_ptr exception = nullptr;
+
+            task get_return_object() noexcept { return task{ std::coroutine_handle<promise_type>::from_promise(*this) }; }
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+            auto final_suspend() const noexcept {
+                struct final_awaiter {
+                    bool await_ready() const noexcept { return false; }
+                    std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) const noexcept {
+                        if(const auto continuation = handle.promise().continuation; continuation) return continuation;
+                        return std::noop_coroutine();
+                    }
+                    void await_resume() const noexcept {}
+                };
+                return final_awaiter{};
+            }
+            void unhandled_exception() noexcept { exception = std::current_exception(); }
+        };
+
+    private:
+        friend class reactor;
+        std::coroutine_handle<promise_type> handle;
+        explicit task(std::coroutine_handle<promise_type> h) noexcept : handle(h) {}
+    public:
+        task(const task&) = delete;
+        task(task&& src) noexcept : handle(std::exchange(src.handle, nullptr)) {}
+        ~task() { if(handle) handle.destroy(); }
+
+        [[nodiscard]] bool done() const noexcept { return handle && handle.done(); }
+        // Returns the value of the finished task, or rethrows the exception thrown in it.
+        decltype(auto) get() {
+            if(handle.promise().exception) std::rethrow_exception(handle.promise().exception);
+            return handle.promise().get();
+        }
+
+        bool await_ready() const noexcept { return done(); }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+            handle.promise().continuation = awaiting;
+            return handle;
+        }
+        T await_resume() {
+            if(handle.promise().exception) std::rethrow_exception(handle.promise().exception);
+            return handle.promise().take();
+        }
+    };
+
+    namespace detail {
+        // State of a query sent by PQsendQueryParams, which is received by PQconsumeInput and PQgetResult.
+        class async_query : public reactor::waiter {
+        protected:
+            postgresql_connector* connector;
+            ::PGresult* result = nullptr;
+            // events to wait for, 0 if all results are received
+            std::uint32_t events = 0;
+
+            async_query(postgresql_connector& conn, const bool sent);
+            async_query(async_query&& src) noexcept;
+            ~async_query();
+            // Receive all results, waiting for the socket on this thread.
+            void wait_blocking();
+            ::PGconn* connection() const noexcept;
+            void finish();
+        public:
+            std::uint32_t on_ready() override;
+
+            bool await_ready() const noexcept;
+            bool await_suspend(std::coroutine_handle<> handle);
+        };
+    }
+
+    /*
+     * Awaitable result of postgresql_connector::exec_async.
+     * The query is sent when it is made, and the connection can not execute other queries until the result is awaited.
+     * Without a running reactor, co_await waits on the current thread.
+     */
+    template<typename Result>
+    class async_result : public detail::async_query {
+    private:
+        friend class arcxx::postgresql_connector;
+        async_result(postgresql_connector& conn, const bool sent) : detail::async_query(conn, sent) {}
+    public:
+        async_result(const async_result&) = delete;
+        async_result(async_result&&) noexcept = default;
+        ~async_result() = default;
+
+        arcxx::expected<Result, arcxx::string> await_resume();
+    };
+
+    inline reactor::reactor() : epoll_fd(epoll_create1(EPOLL_CLOEXEC)) {
+        if(epoll_fd == -1) error_msg = arcxx::string{ "failed to create epoll. " } + std::strerror(errno);
+    }
+    inline reactor::~reactor() {
+        if(epoll_fd != -1) ::close(epoll_fd);
+    }
+
+    inline bool reactor::has_error() const noexcept {
+        return static_cast<bool>(error_msg);
+    }
+    inline const arcxx::string& reactor::error_message() const {
+        return error_msg.value();
+    }
+
+    inline reactor* reactor::current() noexcept {
+        return running;
+    }
+
+    inline bool reactor::wait(waiter& w, const std::uint32_t events, std::coroutine_handle<> handle) {
+        // A socket has one waiting operation, which is removed when the coroutine is resumed.
+        ::epoll_event event{ .events = events | EPOLLONESHOT, .data = { .ptr = &w } };
+        if(epoll_fd == -1 || epoll_ctl(epoll_fd, EPOLL_CTL_ADD, w.fd, &event) == -1) return false;
+        w.handle = handle;
+        ++waiting_count;
+        return true;
+    }
+    inline void reactor::post(std::coroutine_handle<> handle) {
+        ready.push_back(handle);
+    }
+    template<typename T>
+    inline void reactor::spawn(task<T>& t) {
+        if(t.handle && !t.handle.done()) post(t.handle);
+    }
+
+    inline arcxx::expected<void, arcxx::string> reactor::run() {
+        if(error_msg) return arcxx::make_unexpected(error_msg.value());
+        reactor* const previous = std::exchange(running, this);
+        std::array<::epoll_event, 64> events;
+        while(!ready.empty() || waiting_count != 0) {
+            while(!ready.empty()) {
+                const auto handle = ready.front();
+                ready.pop_front();
+                handle.resume();
+            }
+            if(waiting_count == 0) break;
+
+            const int count = epoll_wait(epoll_fd, events.data(), static_cast<int>(events.size()), -1);
+            if(count == -1) {
+                if(errno == EINTR) continue;
+                error_msg = arcxx::string{ "failed to wait for sockets. " } + std::strerror(errno);
+                break;
+            }
+            for(int i = 0; i < count; ++i) {
+                auto& w = *static_cast<waiter*>(events[i].data.ptr);
+                if(const auto next = w.on_ready(); next != 0) {
+                    ::epoll_event event{ .events = next | EPOLLONESHOT, .data = { .ptr = &w } };
+                    if(epoll_ctl(epoll_fd, EPOLL_CTL_MOD, w.fd, &event) == 0) continue;
+                }
+                // resumed coroutine may close the socket
+                epoll_ctl(epoll_fd, EPOLL_CTL_DEL, w.fd, nullptr);
+                --waiting_count;
+                ready.push_back(w.handle);
+            }
+        }
+        running = previous;
+        if(error_msg) return arcxx::make_unexpected(error_msg.value());
+        return {};
+    }
+    inline std::size_t reactor::waiting() const noexcept {
+        return waiting_count;
+    }
+
+    inline detail::async_query::async_query(postgresql_connector& conn, const bool sent) : connector(&conn) {
+        fd = PQsocket(connection());
+        if(sent && fd != -1) events = EPOLLIN;
+        else {
+            // the result has the error message of the connection
+            result = PQmakeEmptyPGresult(connection(), PGRES_FATAL_ERROR);
+            finish();
+        }
+    }
+    inline detail::async_query::async_query(async_query&& src) noexcept
+        : connector(src.connector), result(std::exchange(src.result, nullptr)), events(std::exchange(src.events, 0)) {
+        fd = src.fd;
+    }
+    inline detail::async_query::~async_query() {
+        // results of the query which is not awaited are discarded
+        if(events != 0) wait_blocking();
+        if(result != nullptr) PQclear(result);
+    }
+
+    inline ::PGconn* detail::async_query::connection() const noexcept {
+        return connector->conn;
+    }
+    inline void detail::async_query::finish() {
+        events = 0;
+        PQsetnonblocking(connection(), 0);
+    }
+
+    inline std::uint32_t detail::async_query::on_ready() {
+        ::PGconn* const conn = connection();
+        // Input is consumed while sending, since the server may wait for the client to read.
+        if(PQconsumeInput(conn) == 0) {
+            if(result == nullptr) result = PQmakeEmptyPGresult(conn, PGRES_FATAL_ERROR);
+            finish();
+            return events;
+        }
+        if(const int flushed = PQflush(conn); flushed == 1) {
+            return events = EPOLLIN | EPOLLOUT;
+        }
+        else if(flushed == -1) {
+            if(result == nullptr) result = PQmakeEmptyPGresult(conn, PGRES_FATAL_ERROR);
+            finish();
+            return events;
+        }
+        while(PQisBusy(conn) == 0) {
+            ::PGresult* const received = PQgetResult(conn);
+            if(received == nullptr) {
+                if(result == nullptr) result = PQmakeEmptyPGresult(conn, PGRES_FATAL_ERROR);
+                finish();
+                return events;
+            }
+            // the first result is the result of the query
+            if(result == nullptr) result = received;
+            else PQclear(received);
+        }
+        return events = EPOLLIN;
+    }
+
+    inline void detail::async_query::wait_blocking() {
+        while(events != 0) {
+            ::pollfd target{ .fd = fd, .events = static_cast<short>(((events & EPOLLIN) ? POLLIN : 0) | ((events & EPOLLOUT) ? POLLOUT : 0)), .revents = 0 };
+            if(::poll(&target, 1, -1) == -1 && errno != EINTR) {
+                if(result == nullptr) result = PQmakeEmptyPGresult(connection(), PGRES_FATAL_ERROR);
+                finish();
+                return;
+            }
+            on_ready();
+        }
+    }
+
+    inline bool detail::async_query::await_ready() const noexcept {
+        return events == 0;
+    }
+    inline bool detail::async_query::await_suspend(std::coroutine_handle<> handle) {
+        // The result may be received by on_ready() before the socket is waited for.
+        if(on_ready() == 0) return false;
+        if(auto* const loop = reactor::current(); loop != nullptr && loop->wait(*this, events, handle)) return true;
+        wait_blocking();
+        return false;
+    }
+
+    template<typename Result>
+    inline arcxx::expected<Result, arcxx::string> async_result<Result>::await_resume() {
+        if constexpr(std::is_void_v<Result>) {
+            auto exec_result = postgresql_connector::decode_result<void>(std::exchange(result, nullptr));
+            if(!exec_result) connector->error_msg = exec_result.error();
+            return exec_result;
+        }
+        else {
+            return postgresql_connector::decode_result<Result>(std::exchange(result, nullptr));
+        }
+    }
+}
+
+namespace arcxx {
+    template<typename Result, specialized_from<std::tuple> BindAttrs>
+    inline auto postgresql_connector::exec_async(const query_relation<Result, BindAttrs>& query) -> PostgreSQL::async_result<Result> {
+        return with_parameters(query, [this](const auto& sql, const int param_count, const ::Oid* param_types, const char* const* param_values, const int* param_length, const int* param_formats) {
+            return PostgreSQL::async_result<Result>{ *this, send_params(sql, param_count, param_types, param_values, param_length, param_formats) };
+        });
+    }
+
+    inline bool postgresql_connector::send_params(const arcxx::string_view sql, const int param_count, const ::Oid* param_types, const char* const* param_values, const int* param_length, const int* param_formats) {
+        if(PQsetnonblocking(conn, 1) != 0) return false;
+        // Statements are not prepared here, since preparing needs another round trip. Cached statements are reused.
+        const arcxx::string* name = statements.capacity() != 0 ? statements.find(sql) : nullptr;
+        const int sent = (name == nullptr)
+            ? PQsendQueryParams(conn, sql.data(), param_count, param_types, param_values, param_length, param_formats, result_format)
+            : PQsendQueryPrepared(conn, name->c_str(), param_count, param_values, param_length, param_formats, result_format);
+        return sent == 1;
+    }
+}
+#endif
@@ -7,7 +7,8 @@
  */
 
 namespace arcxx {
-    inline postgresql_connector::postgresql_connector(const PostgreSQL::endpoint& endpoint_info, const std::optional<PostgreSQL::auth>& auth_info, const std::optional<PostgreSQL::options> option) {
+    inline postgresql_connector::postgresql_connector(const PostgreSQL::endpoint& endpoint_info, const std::optional<PostgreSQL::auth>& auth_info, const std::optional<PostgreSQL::options> option)
+        : statements(default_statement_cache_capacity) {
         conn = PQsetdbLogin(
             endpoint_info.server_name.c_str(),
             endpoint_info.port.c_str(),
@@ -22,7 +23,8 @@ namespace arcxx {
             error_msg = PQerrorMessage(conn);
         }
     }
-    inline postgresql_connector::postgresql_connector(const arcxx::string& info){
+    inline postgresql_connector::postgresql_connector(const arcxx::string& info)
+        : statements(default_statement_cache_capacity) {
         conn = PQconnectdb(info.c_str());
         if (PQstatus(conn) == CONNECTION_BAD){
             // handle error
@@ -30,7 +32,12 @@ namespace arcxx {
         }
     }
 
-    inline postgresql_connector::postgresql_connector(postgresql_connector&& src){
+    inline postgresql_connector::postgresql_connector(::PGconn* started_conn)
+        : conn(started_conn), statements(default_statement_cache_capacity) {
+    }
+
+    inline postgresql_connector::postgresql_connector(postgresql_connector&& src)
+        : statements(std::move(src.statements)), prepared_count(src.prepared_count), result_format(src.result_format) {
         conn = src.conn;
         src.conn = nullptr;
 
@@ -41,16 +48,12 @@ namespace arcxx {
         this->close();
     }
 
-    template<typename Result, specialized_from<std::tuple> BindAttrs>
-    inline PGresult* postgresql_connector::exec_sql(const query_relation<Result, BindAttrs>& query, ::PGconn* conn) {
+    template<typename Result, specialized_from<std::tuple> BindAttrs, typename F>
+    inline auto postgresql_connector::with_parameters(const query_relation<Result, BindAttrs>& query, F&& f) {
         const auto sql = query.template to_sql<postgresql_connector>();
 
-        PGresult* result = nullptr;
         if constexpr(query.bind_attrs_count() == 0){
-            result = PQexec(
-                conn,
-                sql.c_str()
-            );
+            return f(sql, 0, nullptr, nullptr, nullptr, nullptr);
         }
         else{
             const auto param_length = std::apply(
@@ -59,21 +62,14 @@ namespace arcxx {
                 },
                 query.bind_attrs
             );
-            const auto param_format = std::apply(
-                []<typename... Attrs>(const Attrs&... attrs){
-                    const auto is_not_text_format = []<typename Attr>([[maybe_unused]]const Attr&){
-                        return static_cast<int>(
-                            !(std::is_same_v<typename Attr::value_type, arcxx::string> ||
-                            regarded_as_clock<typename Attr::value_type>) ||
-                            std::floating_point<typename Attr::value_type>
-                        );
-                    };
-                    return std::array<int, sizeof...(Attrs)>{ is_not_text_format(attrs)... };
-                },
-                query.bind_attrs
-            );
+            constexpr auto param_format = []<typename... Attrs>(std::tuple<Attrs...>*){
+                return std::array<int, sizeof...(Attrs)>{ PostgreSQL::detail::parameter_format<Attrs>()... };
+            }(static_cast<BindAttrs*>(nullptr));
+            constexpr auto param_types = []<typename... Attrs>(std::tuple<Attrs...>*){
+                return std::array<::Oid, sizeof...(Attrs)>{ PostgreSQL::detail::parameter_oid<Attrs>()... };
+            }(static_cast<BindAttrs*>(nullptr));
 
-            std::array<std::any, query.bind_attrs_count()> temporary_values;
+            std::array<PostgreSQL::detail::parameter_buffer, query.bind_attrs_count()> temporary_values;
             const auto param_values = std::apply(
                 []<typename... Ptrs>(const Ptrs... ptrs){ return std::array<const char* const, sizeof...(Ptrs)>{ptrs...}; },
                 tuptup::indexed_apply_each(
@@ -84,18 +80,96 @@ namespace arcxx {
                 )
             );
 
-            result = PQexecParams(
-                conn,
-                sql.c_str(),
-                std::tuple_size_v<BindAttrs>, // parameter count
-                NULL, // parameter types
+            return f(
+                sql,
+                static_cast<int>(std::tuple_size_v<BindAttrs>), // parameter count
+                param_types.data(), // parameter types
                 param_values.data(), // parameter values
                 param_length.data(), // parameter length
-                param_format.data(), // parameter formats
-                0  // result formats(text)
+                param_format.data() // parameter formats
             );
         }
-        return result;
+    }
+
+    template<typename Result, specialized_from<std::tuple> BindAttrs>
+    inline PGresult* postgresql_connector::exec_sql(const query_relation<Result, BindAttrs>& query, const int chunk_rows) {
+        return with_parameters(query, [this, chunk_rows](const auto& sql, const int param_count, const ::Oid* param_types, const char* const* param_values, const int* param_length, const int* param_formats) {
+            // PQexec can execute multiple statements, but it receives results in text format
+            if(param_count == 0 && chunk_rows == 0 && (std::is_void_v<Result> || result_format == 0)) {
+                return PQexec(conn, sql.c_str());
+            }
+            return exec_params(sql, param_count, param_types, param_values, param_length, param_formats, chunk_rows);
+        });
+    }
+
+    template<typename Result>
+    inline arcxx::expected<Result, arcxx::string> postgresql_connector::decode_result(::PGresult* pg_result) {
+        const auto exec_func = [pg_result]{ return pg_result; };
+        if constexpr(std::is_void_v<Result>){
+            return executer<void>{ exec_func }.execute();
+        }
+        else{
+            Result result{};
+            for(auto exec_result : executer<typename PostgreSQL::detail::row_type<Result>::type>{ exec_func }){
+                if(!exec_result){
+                    return arcxx::make_unexpected(std::move(exec_result.error()));
+                }
+                else{
+                    if constexpr(specialized_from<Result, std::vector>){
+                        result.push_back(exec_result.value().get());
+                    }
+                    else if constexpr(specialized_from<Result, std::unordered_map>){
+                        result.insert(exec_result.value().get());
+                    }
+                    else{
+                        result = exec_result.value().get();
+                    }
+                }
+            }
+            return result;
+        }
+    }
+
+    inline PGresult* postgresql_connector::exec_params(const arcxx::string_view sql, const int param_count, const ::Oid* param_types, const char* const* param_values, const int* param_length, const int* param_formats, const int chunk_rows) {
+        const arcxx::string* name = statements.capacity() != 0 ? statements.find(sql) : nullptr;
+        if(name == nullptr && statements.capacity() != 0) {
+            const auto& inserted = statements.insert(sql, arcxx::string{ "arcxx_" } + std::to_string(++prepared_count).c_str());
+            PGresult* prepared = PQprepare(conn, inserted.statement.c_str(), inserted.sql.c_str(), param_count, param_types);
+            if(PQresultStatus(prepared) != PGRES_COMMAND_OK) {
+                static_cast<void>(statements.erase(sql));
+                return prepared;
+            }
+            PQclear(prepared);
+            name = &inserted.statement;
+            // the inserted statement is the most recently used one, so it is not evicted
+            while(const auto evicted = statements.pop_overflow()) {
+                deallocate(evicted.value());
+            }
+        }
+        if(chunk_rows == 0) {
+            if(name == nullptr) return PQexecParams(conn, sql.data(), param_count, param_types, param_values, param_length, param_formats, result_format);
+            return PQexecPrepared(conn, name->c_str(), param_count, param_values, param_length, param_formats, result_format);
+        }
+
+        const int sent = (name == nullptr)
+            ? PQsendQueryParams(conn, sql.data(), param_count, param_types, param_values, param_length, param_formats, result_format)
+            : PQsendQueryPrepared(conn, name->c_str(), param_count, param_values, param_length, param_formats, result_format);
+        if(sent == 0) {
+            // the result has the error message of the connection
+            return PQmakeEmptyPGresult(conn, PGRES_FATAL_ERROR);
+        }
+        #ifdef LIBPQ_HAS_CHUNK_MODE
+        if(chunk_rows > 1) PQsetChunkedRowsMode(conn, chunk_rows);
+        else PQsetSingleRowMode(conn);
+        #else
+        PQsetSingleRowMode(conn);
+        #endif
+        return PQgetResult(conn);
+    }
+
+    inline void postgresql_connector::deallocate(const arcxx::string& statement_name) {
+        // It fails in an aborted transaction, then the statement remains until the session ends.
+        PQclear(PQexec(conn, ("DEALLOCATE " + statement_name).c_str()));
     }
     inline bool postgresql_connector::has_error() const noexcept {
         return static_cast<bool>(error_msg);
@@ -103,6 +177,16 @@ namespace arcxx {
     inline const arcxx::string& postgresql_connector::error_message() const {
         return error_msg.value();
     }
+    inline void postgresql_connector::clear_error() noexcept {
+        error_msg = std::nullopt;
+    }
+    inline bool postgresql_connector::connected() const noexcept {
+        return conn != nullptr && PQstatus(conn) == CONNECTION_OK;
+    }
+    inline bool postgresql_connector::in_transaction() const noexcept {
+        const auto status = PQtransactionStatus(conn);
+        return status == PQTRANS_INTRANS || status == PQTRANS_INERROR;
+    }
 
     inline postgresql_connector postgresql_connector::open(const PostgreSQL::endpoint endpoint_info, const std::optional<PostgreSQL::auth> auth_info, const std::optional<PostgreSQL::options> option){
         return postgresql_connector(endpoint_info, auth_info, option);
@@ -110,6 +194,61 @@ namespace arcxx {
     inline postgresql_connector postgresql_connector::open(const arcxx::string& connection_info){
         return postgresql_connector(connection_info);
     }
+    inline std::vector<postgresql_connector> postgresql_connector::open_many(const std::size_t count, const arcxx::string& connection_info){
+        std::vector<postgresql_connector> connectors;
+        connectors.reserve(count);
+        // indexes of connections in progress and their polling status
+        std::vector<std::pair<std::size_t, PostgresPollingStatusType>> connecting;
+        for(std::size_t i = 0; i < count; ++i) {
+            connectors.push_back(postgresql_connector{ PQconnectStart(connection_info.c_str()) });
+            if(PQstatus(connectors.back().conn) != CONNECTION_BAD) connecting.emplace_back(i, PGRES_POLLING_WRITING);
+        }
+
+        // connections which are in progress at the deadline fail, as PQconnectdb does
+        std::optional<std::chrono::steady_clock::time_point> deadline = std::nullopt;
+        if(!connecting.empty()) {
+            if(const auto timeout = PostgreSQL::detail::connect_timeout(connectors[connecting.front().first].conn)) {
+                deadline = std::chrono::steady_clock::now() + timeout.value();
+            }
+        }
+        bool timed_out = false;
+        std::vector<::pollfd> sockets;
+        while(!connecting.empty()) {
+            sockets.clear();
+            for(const auto& [index, status] : connecting) {
+                const short events = status == PGRES_POLLING_READING ? POLLIN : POLLOUT;
+                sockets.push_back(::pollfd{ .fd = PQsocket(connectors[index].conn), .events = events, .revents = 0 });
+            }
+            int timeout_ms = -1;
+            if(deadline) {
+                const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline.value() - std::chrono::steady_clock::now()).count();
+                if(remaining <= 0) {
+                    timed_out = true;
+                    break;
+                }
+                timeout_ms = static_cast<int>(std::min<decltype(remaining)>(remaining, std::numeric_limits<int>::max()));
+            }
+            if(PostgreSQL::detail::poll_sockets(sockets, timeout_ms) == -1 && errno != EINTR) break;
+
+            for(std::size_t i = 0; i < sockets.size(); ++i) {
+                if(sockets[i].revents != 0) connecting[i].second = PQconnectPoll(connectors[connecting[i].first].conn);
+            }
+            std::erase_if(connecting, [](const auto& connection){
+                return connection.second == PGRES_POLLING_OK || connection.second == PGRES_POLLING_FAILED;
+            });
+        }
+        for(auto& connector : connectors) {
+            if(PQstatus(connector.conn) != CONNECTION_OK) connector.error_msg = PQerrorMessage(connector.conn);
+        }
+        if(timed_out) {
+            for(const auto& connection : connecting) {
+                auto& connector = connectors[connection.first];
+                connector.close();
+                connector.error_msg = "timeout expired while connecting";
+            }
+        }
+        return connectors;
+    }
 
     inline int postgresql_connector::protocol_version() const {
         return PQprotocolVersion(conn);
@@ -123,52 +262,119 @@ namespace arcxx {
             PQfinish(conn);
             conn = nullptr;
         }
+        // prepared statements are released with the session
+        static_cast<void>(statements.clear());
+    }
+    inline arcxx::expected<void, arcxx::string> postgresql_connector::reconnect() {
+        static_cast<void>(statements.clear());
+        PQreset(conn);
+        if (PQstatus(conn) == CONNECTION_BAD){
+            error_msg = PQerrorMessage(conn);
+            return arcxx::make_unexpected(error_msg.value());
+        }
+        return {};
+    }
+
+    inline std::size_t postgresql_connector::statement_cache_capacity() const noexcept {
+        return statements.capacity();
+    }
+    inline std::size_t postgresql_connector::statement_cache_size() const noexcept {
+        return statements.size();
+    }
+    inline void postgresql_connector::set_statement_cache_capacity(const std::size_t capacity) {
+        statements.set_capacity(capacity);
+        while(const auto evicted = statements.pop_overflow()) {
+            deallocate(evicted.value());
+        }
+    }
+
+    inline void postgresql_connector::set_binary_results(const bool enable) noexcept {
+        result_format = static_cast<int>(enable);
+    }
+    inline bool postgresql_connector::binary_results() const noexcept {
+        return result_format == 1;
     }
     inline arcxx::string postgresql_connector::bind_variable_str(const std::size_t idx, arcxx::string&& buff) {
         std::array<arcxx::string::value_type, 8> char_buff{0};
         std::to_chars(std::to_address(char_buff.begin()), std::to_address(char_buff.end()), idx+1);
         buff.reserve(buff.size() + 8);
-        buff += "$";
+        buff += bind_variable_prefix;
         buff += char_buff.data();
         return std::move(buff);
     }
 
+    inline std::size_t postgresql_connector::bind_variable_limit() const noexcept {
+        return 65535;
+    }
+    template<is_attribute Attr>
+    inline constexpr arcxx::string_view postgresql_connector::parameter_type() noexcept {
+        return PostgreSQL::detail::parameter_type<Attr>();
+    }
+
     template<specialized_from<std::vector> Result, specialized_from<std::tuple> BindAttrs>
     inline auto postgresql_connector::make_executer(const query_relation<Result, BindAttrs>& query) -> arcxx::expected<executer<typename Result::value_type>, arcxx::string>{
         return executer<typename Result::value_type>{
-            [query, conn = this->conn]{ return postgresql_connector::exec_sql(query, conn); }
+            [this, query]{ return exec_sql(query); }
         };
     }
     template<specialized_from<std::vector> Result, specialized_from<std::tuple> BindAttrs>
     inline auto postgresql_connector::make_executer(query_relation<Result, BindAttrs>&& query) -> arcxx::expected<executer<typename Result::value_type>, arcxx::string>{
         return executer<typename Result::value_type>{
-            [query = std::move(query), conn = this->conn]{ return postgresql_connector::exec_sql(query, conn); }
+            [this, query = std::move(query)]{ return exec_sql(query); }
         };
     }
 
     template<specialized_from<std::unordered_map> Result, specialized_from<std::tuple> BindAttrs>
     inline auto postgresql_connector::make_executer(const query_relation<Result, BindAttrs>& query) -> arcxx::expected<executer<std::pair<typename Result::key_type, typename Result::mapped_type>>, arcxx::string>{
         return executer<std::pair<typename Result::key_type, typename Result::mapped_type>>{
-            [query, conn = this->conn]{ return postgresql_connector::exec_sql(query, conn); }
+            [this, query]{ return exec_sql(query); }
         };
     }
     template<specialized_from<std::unordered_map> Result, specialized_from<std::tuple> BindAttrs>
     inline auto postgresql_connector::make_executer(query_relation<Result, BindAttrs>&& query) -> arcxx::expected<executer<std::pair<typename Result::key_type, typename Result::mapped_type>>, arcxx::string>{
         return executer<std::pair<typename Result::key_type, typename Result::mapped_type>>{
-            [query = std::move(query), conn = this->conn]{ return postgresql_connector::exec_sql(query, conn); }
+            [this, query = std::move(query)]{ return exec_sql(query); }
         };
     }
 
     template<typename Result, specialized_from<std::tuple> BindAttrs>
     inline auto postgresql_connector::make_executer(const query_relation<Result, BindAttrs>& query) -> arcxx::expected<executer<Result>, arcxx::string>{
         return executer<Result>{
-            [query, conn = this->conn]{ return postgresql_connector::exec_sql(query, conn); }
+            [this, query]{ return exec_sql(query); }
         };
     }
     template<typename Result, specialized_from<std::tuple> BindAttrs>
     inline auto postgresql_connector::make_executer(query_relation<Result, BindAttrs>&& query) -> arcxx::expected<executer<Result>, arcxx::string>{
         return executer<Result>{
-            [query = std::move(query), conn = this->conn]{ return postgresql_connector::exec_sql(query, conn); }
+            [this, query = std::move(query)]{ return exec_sql(query); }
+        };
+    }
+
+    template<typename Result, specialized_from<std::tuple> BindAttrs>
+    inline auto postgresql_connector::make_view_executer(const query_relation<Result, BindAttrs>& query) -> arcxx::expected<executer<PostgreSQL::row_view>, arcxx::string>{
+        return executer<PostgreSQL::row_view>{
+            [this, query]{ return exec_sql(query); }
+        };
+    }
+    template<typename Result, specialized_from<std::tuple> BindAttrs>
+    inline auto postgresql_connector::make_view_executer(query_relation<Result, BindAttrs>&& query) -> arcxx::expected<executer<PostgreSQL::row_view>, arcxx::string>{
+        return executer<PostgreSQL::row_view>{
+            [this, query = std::move(query)]{ return exec_sql(query); }
+        };
+    }
+
+    template<specialized_from<std::vector> Result, specialized_from<std::tuple> BindAttrs>
+    inline auto postgresql_connector::make_streaming_executer(const query_relation<Result, BindAttrs>& query, const int chunk_rows) -> arcxx::expected<executer<typename Result::value_type>, arcxx::string>{
+        return executer<typename Result::value_type>{
+            [this, query, chunk_rows]{ return exec_sql(query, std::max(chunk_rows, 1)); },
+            conn
+        };
+    }
+    template<specialized_from<std::vector> Result, specialized_from<std::tuple> BindAttrs>
+    inline auto postgresql_connector::make_streaming_executer(query_relation<Result, BindAttrs>&& query, const int chunk_rows) -> arcxx::expected<executer<typename Result::value_type>, arcxx::string>{
+        return executer<typename Result::value_type>{
+            [this, query = std::move(query), chunk_rows]{ return exec_sql(query, std::max(chunk_rows, 1)); },
+            conn
         };
     }
 
@@ -196,45 +402,244 @@ namespace arcxx {
 
     template<typename Result, specialized_from<std::tuple> BindAttrs>
     inline arcxx::expected<Result, arcxx::string> postgresql_connector::exec(const query_relation<Result, BindAttrs>& query){
-        auto make_executer_result = make_executer(query);
-        if(!make_executer_result){
-            error_msg = make_executer_result.error();
-            return arcxx::make_unexpected(std::move(make_executer_result.error()));
+        return decode_result<Result>(exec_sql(query));
+    }
+
+    template<specialized_from<std::tuple> BindAttrs>
+    inline arcxx::expected<void, arcxx::string> postgresql_connector::exec(const query_relation<void, BindAttrs>& query){
+        if(auto exec_result = decode_result<void>(exec_sql(query)); !exec_result){
+            error_msg = exec_result.error();
+            return arcxx::make_unexpected(std::move(exec_result.error()));
         }
+        else return arcxx::expected<void, arcxx::string>{};
+    }
+
+    template<specialized_from<std::vector> Result, specialized_from<std::tuple> BindAttrs>
+    inline arcxx::expected<columnar_result_t<Result>, arcxx::string> postgresql_connector::exec_columnar(const query_relation<Result, BindAttrs>& query){
+        ::PGresult* pg_result = exec_sql(query);
+        if(!PostgreSQL::detail::has_rows_status(PQresultStatus(pg_result))){
+            arcxx::string error_message = pg_result != nullptr ? PQresultErrorMessage(pg_result) : PQerrorMessage(conn);
+            PQclear(pg_result);
+            return arcxx::make_unexpected(std::move(error_message));
+        }
+        columnar_result_t<Result> result{};
+        result.reserve(static_cast<std::size_t>(PQntuples(pg_result)));
+        // column by column, so that each column is written sequentially, until a column cannot be decoded
+        int failed_field = -1;
+        [pg_result, &result, &failed_field]<std::size_t... N>(std::index_sequence<N...>){
+            static_cast<void>(((PostgreSQL::detail::append_column(pg_result, static_cast<int>(N), result.template get<N>()) || (failed_field = static_cast<int>(N), false)) && ...));
+        }(std::make_index_sequence<columnar_result_t<Result>::column_count>{});
+        if(failed_field >= 0){
+            arcxx::string error_message = concat_strings("failed to decode column ", arcxx::string_view{ PQfname(pg_result, failed_field) }, " of the result");
+            PQclear(pg_result);
+            return arcxx::make_unexpected(std::move(error_message));
+        }
+        PQclear(pg_result);
+        return result;
+    }
 
-        Result result{};
-        for(auto exec_result : make_executer_result.value()){
-            if(!exec_result){
-                return arcxx::make_unexpected(std::move(exec_result.error()));
+    template<typename Result, specialized_from<std::tuple> BindAttrs>
+    inline arcxx::expected<PostgreSQL::result_view, arcxx::string> postgresql_connector::exec_view(const query_relation<Result, BindAttrs>& query){
+        ::PGresult* pg_result = exec_sql(query);
+        if(!PostgreSQL::detail::has_rows_status(PQresultStatus(pg_result))){
+            arcxx::string error_message = pg_result != nullptr ? PQresultErrorMessage(pg_result) : PQerrorMessage(conn);
+            PQclear(pg_result);
+            return arcxx::make_unexpected(std::move(error_message));
+        }
+        return PostgreSQL::result_view{ pg_result };
+    }
+
+    template<specialized_from<std::tuple> BindRow>
+    inline arcxx::expected<std::size_t, arcxx::string> postgresql_connector::exec(const multi_row_query_relation<BindRow>& query){
+        const std::size_t rows_per_statement = query.rows_per_statement(bind_variable_limit());
+        constexpr std::size_t row_bind_count = query.row_bind_count();
+        constexpr auto param_format = []<typename... Attrs>(std::tuple<Attrs...>*){
+            return std::array<int, sizeof...(Attrs)>{ PostgreSQL::detail::parameter_format<Attrs>()... };
+        }(static_cast<BindRow*>(nullptr));
+        constexpr auto param_type = []<typename... Attrs>(std::tuple<Attrs...>*){
+            return std::array<::Oid, sizeof...(Attrs)>{ PostgreSQL::detail::parameter_oid<Attrs>()... };
+        }(static_cast<BindRow*>(nullptr));
+
+        arcxx::string sql;
+        std::size_t sql_rows = 0;
+        std::vector<const char*> param_values;
+        std::vector<int> param_length;
+        std::vector<int> param_formats;
+        std::vector<::Oid> param_types;
+        std::vector<PostgreSQL::detail::parameter_buffer> temporary_values;
+        std::size_t changes = 0;
+        for(std::size_t first = 0; first < query.rows.size(); first += rows_per_statement) {
+            const std::size_t count = std::min(rows_per_statement, query.rows.size() - first);
+            // all chunks except for the last one have the same SQL
+            if(count != sql_rows) {
+                query.template to_sql_into<postgresql_connector>(sql, first, count);
+                sql_rows = count;
             }
-            else{
-                if constexpr(specialized_from<Result, std::vector>){
-                    result.push_back(exec_result.value().get());
-                }
-                else if constexpr(specialized_from<Result, std::unordered_map>){
-                    result.insert(exec_result.value().get());
-                }
-                else{
-                    result = exec_result.value().get();
-                }
+
+            const std::size_t param_count = count * row_bind_count;
+            param_values.resize(param_count);
+            param_length.resize(param_count);
+            param_formats.resize(param_count);
+            param_types.resize(param_count);
+            temporary_values.resize(param_count);
+            for(std::size_t i = 0; i < count; ++i) {
+                const std::size_t offset = i * row_bind_count;
+                tuptup::indexed_apply_each(
+                    [&, offset]<std::size_t N, typename Attr>(const Attr& attr){
+                        param_values[offset + N] = PostgreSQL::detail::get_value_ptr(attr, temporary_values[offset + N]);
+                        param_length[offset + N] = static_cast<int>(PostgreSQL::detail::attribute_size(attr));
+                        param_formats[offset + N] = param_format[N];
+                        param_types[offset + N] = param_type[N];
+                    },
+                    query.rows[first + i]
+                );
+            }
+
+            PGresult* result = exec_params(
+                sql,
+                static_cast<int>(param_count), // parameter count
+                param_types.data(), // parameter types
+                param_values.data(), // parameter values
+                param_length.data(), // parameter length
+                param_formats.data() // parameter formats
+            );
+            if (const auto stat = PQresultStatus(result); stat != PGRES_COMMAND_OK && stat != PGRES_NONFATAL_ERROR){
+                error_msg = PQresultErrorMessage(result);
+                PQclear(result);
+                return arcxx::make_unexpected(error_msg.value());
             }
+            changes += static_cast<std::size_t>(std::strtoull(PQcmdTuples(result), nullptr, 10));
+            PQclear(result);
         }
-        return result;
+        return changes;
     }
 
-    template<specialized_from<std::tuple> BindAttrs>
-    inline arcxx::expected<void, arcxx::string> postgresql_connector::exec(const query_relation<void, BindAttrs>& query){
-        auto make_executer_result = make_executer(query);
-        if(!make_executer_result){
-            error_msg = make_executer_result.error();
-            return arcxx::make_unexpected(std::move(make_executer_result.error()));
+    template<is_model Mod, is_attribute... Attrs, std::ranges::input_range Range>
+    requires std::same_as<std::remove_cvref_t<std::ranges::range_reference_t<Range>>, Mod> && (std::same_as<typename Attrs::model_type, Mod> && ...)
+    inline arcxx::expected<std::size_t, arcxx::string> postgresql_connector::copy_in(Range&& models){
+        if constexpr(sizeof...(Attrs) == 0) {
+            using namespace tuptup::type_placeholders;
+            using attributes_t = tuptup::apply_type_t<std::remove_cvref<_1>, decltype(Mod{}.attributes_as_tuple())>;
+            return [this, &models]<typename... ModelAttrs>(std::tuple<ModelAttrs...>*){
+                return copy_in<Mod, ModelAttrs...>(std::forward<Range>(models));
+            }(static_cast<attributes_t*>(nullptr));
         }
+        else {
+            arcxx::string sql = "COPY ";
+            sql += detail::table_name_to_string<Mod>().c_str();
+            sql += "(";
+            sql += detail::column_names_to_string<Attrs...>().c_str();
+            sql += ") FROM STDIN (FORMAT binary)";
+            if(PGresult* started = PQexec(conn, sql.c_str()); PQresultStatus(started) != PGRES_COPY_IN) {
+                error_msg = PQresultErrorMessage(started);
+                PQclear(started);
+                return arcxx::make_unexpected(error_msg.value());
+            }
+            else PQclear(started);
 
-        if(auto exec_result = make_executer_result.value().execute(); !exec_result){
-            error_msg = exec_result.error();
-            return arcxx::make_unexpected(std::move(exec_result.error()));
+            arcxx::string buff;
+            buff.reserve(PostgreSQL::detail::copy_chunk_size * 2);
+            // signature, flags and length of header extension
+            buff.append(PostgreSQL::detail::copy_signature.data(), PostgreSQL::detail::copy_signature.size());
+            buff.append(8, '\0');
+            const auto put = [this, &buff]{
+                const bool ret = PQputCopyData(conn, buff.data(), static_cast<int>(buff.size())) == 1;
+                buff.clear();
+                return ret;
+            };
+
+            bool sent = true;
+            for(const auto& model : models) {
+                PostgreSQL::detail::write_copy_row<Attrs...>(buff, model);
+                if(buff.size() >= PostgreSQL::detail::copy_chunk_size && !(sent = put())) break;
+            }
+            if(sent) {
+                // trailer
+                buff.append(2, '\xff');
+                sent = put();
+            }
+            // COPY fails with the error message
+            PQputCopyEnd(conn, sent ? nullptr : PQerrorMessage(conn));
+
+            PGresult* result = PQgetResult(conn);
+            std::optional<std::size_t> copied;
+            if(PQresultStatus(result) == PGRES_COMMAND_OK) {
+                copied = static_cast<std::size_t>(std::strtoull(PQcmdTuples(result), nullptr, 10));
+            }
+            else error_msg = PQresultErrorMessage(result);
+            PQclear(result);
+            while(PGresult* remaining = PQgetResult(conn)) PQclear(remaining);
+
+            if(!copied) return arcxx::make_unexpected(error_msg.value());
+            return copied.value();
         }
-        else return arcxx::expected<void, arcxx::string>{};
+    }
+
+    template<is_model Mod, typename Result, specialized_from<std::tuple> BindAttrs, typename Sink>
+    requires std::same_as<typename PostgreSQL::detail::row_type<Result>::type, Mod> && (std::invocable<Sink&, const Mod&> || std::output_iterator<Sink, const Mod&>)
+    inline arcxx::expected<std::size_t, arcxx::string> postgresql_connector::copy_out(const query_relation<Result, BindAttrs>& query, Sink&& sink){
+        // COPY can not have parameters
+        const auto select = query.template to_sql<PostgreSQL::detail::literal_connector>();
+        arcxx::string_view select_str = select;
+        while(!select_str.empty() && (select_str.back() == ';' || select_str.back() == ' ')) select_str.remove_suffix(1);
+
+        arcxx::string sql = "COPY (";
+        sql += select_str;
+        sql += ") TO STDOUT (FORMAT binary)";
+        if(PGresult* started = PQexec(conn, sql.c_str()); PQresultStatus(started) != PGRES_COPY_OUT) {
+            error_msg = PQresultErrorMessage(started);
+            PQclear(started);
+            return arcxx::make_unexpected(error_msg.value());
+        }
+        else PQclear(started);
+
+        using namespace tuptup::type_placeholders;
+        using attributes_t = tuptup::apply_type_t<std::remove_cvref<_1>, decltype(Mod{}.attributes_as_tuple())>;
+        Mod model{};
+        std::size_t rows = 0;
+        bool header = true;
+        std::optional<arcxx::string> decode_error;
+        // Each buffer has rows, and the first one follows the header. Invalid rows are received and discarded.
+        char* buff = nullptr;
+        int length = 0;
+        while((length = PQgetCopyData(conn, &buff, 0)) > 0) {
+            const char* pos = buff;
+            const char* const end = buff + length;
+            if(header) {
+                pos = PostgreSQL::detail::read_copy_header(pos, end);
+                header = false;
+            }
+            while(!decode_error && pos != nullptr && pos < end) {
+                // trailer
+                if(end - pos >= 2 && PostgreSQL::detail::load_binary<std::int16_t>(pos) == -1) break;
+                pos = [pos, end, &model]<typename... Attrs>(std::tuple<Attrs...>*){
+                    return PostgreSQL::detail::read_copy_row<Attrs...>(pos, end, model);
+                }(static_cast<attributes_t*>(nullptr));
+                if(pos == nullptr) break;
+                ++rows;
+                if constexpr(std::invocable<Sink&, const Mod&>) {
+                    sink(std::as_const(model));
+                }
+                else {
+                    *sink = std::as_const(model);
+                    ++sink;
+                }
+            }
+            if(pos == nullptr && !decode_error) decode_error = "rows of COPY do not match attributes of the model";
+            PQfreemem(buff);
+        }
+        // -1 is the end of COPY and -2 is an error
+        if(length == -2) error_msg = PQerrorMessage(conn);
+        else if(decode_error) error_msg = decode_error;
+
+        PGresult* result = PQgetResult(conn);
+        const bool copied = length == -1 && PQresultStatus(result) == PGRES_COMMAND_OK;
+        if(!copied && length == -1 && !decode_error) error_msg = PQresultErrorMessage(result);
+        PQclear(result);
+        while(PGresult* remaining = PQgetResult(conn)) PQclear(remaining);
+
+        if(!copied || decode_error) return arcxx::make_unexpected(error_msg.value());
+        return rows;
     }
 
     inline arcxx::expected<void, arcxx::string> postgresql_connector::begin(){
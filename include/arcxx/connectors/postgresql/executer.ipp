@@ -11,13 +11,15 @@ namespace arcxx {
     class postgresql_connector::executer{
     private:
         std::function<::PGresult* ()> exec_func;
+        // connection which streams results, or nullptr
+        ::PGconn* stream_conn;
     public:
         executer() = delete;
         executer(const executer&) = delete;
         executer(executer&&) noexcept;
         template<typename F>
         requires std::is_invocable_r_v<::PGresult*, F>
-        executer(F&& f) noexcept;
+        executer(F&& f, ::PGconn* stream_conn = nullptr) noexcept;
         ~executer() = default;
 
         struct sentinel{};
@@ -25,14 +27,19 @@ namespace arcxx {
         private:
             ::PGresult* pg_result;
             ExecStatusType latest_result;
-            const int pq_tuples_count;
+            int pq_tuples_count;
             int pq_current_tuple;
             ResultType buffer;
+            ::PGconn* stream_conn;
+
+            void set_result(::PGresult*);
+            // Receive the next chunk of streaming rows when the current one is consumed.
+            void receive();
         public:
             iterator() = delete;
             iterator(const iterator&) = delete;
             iterator(iterator&&) = delete;
-            iterator(::PGresult*);
+            iterator(::PGresult*, ::PGconn* stream_conn = nullptr);
             ~iterator();
             bool operator==(sentinel);
             arcxx::expected<std::reference_wrapper<const ResultType>, arcxx::string> operator*();
@@ -60,19 +67,19 @@ namespace arcxx {
 
     template<typename ResultType>
     inline postgresql_connector::executer<ResultType>::executer(executer&& src) noexcept
-        : exec_func(std::move(src.exec_func)){
+        : exec_func(std::move(src.exec_func)), stream_conn(src.stream_conn){
     }
 
     template<typename ResultType>
     template<typename F>
     requires std::is_invocable_r_v<::PGresult*, F>
-    inline postgresql_connector::executer<ResultType>::executer(F&& f) noexcept
-        : exec_func(std::forward<F>(f)){
+    inline postgresql_connector::executer<ResultType>::executer(F&& f, ::PGconn* stream) noexcept
+        : exec_func(std::forward<F>(f)), stream_conn(stream){
     }
 
     template<typename ResultType>
     inline postgresql_connector::executer<ResultType>::iterator postgresql_connector::executer<ResultType>::begin(){
-        return iterator{exec_func()};
+        return iterator{exec_func(), stream_conn};
     }
     template<typename ResultType>
     inline postgresql_connector::executer<ResultType>::sentinel postgresql_connector::executer<ResultType>::end() const noexcept {
@@ -110,6 +117,9 @@ namespace arcxx {
             }
             const char* const value_text = PQgetvalue(res, col, field);
             if (value_text == nullptr) return false;
+            if (PQfformat(res, field) == 1) {
+                return PostgreSQL::detail::from_binary(attr, PQftype(res, field), value_text, PQgetlength(res, col, field));
+            }
             from_string<postgresql_connector>(attr, arcxx::string_view{ value_text });
             return true;
         }
@@ -118,6 +128,11 @@ namespace arcxx {
         inline bool set_column_data(PGresult* res, int col, int field, T& result) {
             const char* const text_ptr = PQgetvalue(res, col, field);
             if (text_ptr == nullptr) return false;
+            if constexpr(std::integral<T> || std::floating_point<T>) {
+                if (PQfformat(res, field) == 1) {
+                    return PostgreSQL::detail::from_binary(result, PQftype(res, field), text_ptr, PQgetlength(res, col, field));
+                }
+            }
             const auto value_text = arcxx::string{ text_ptr };
             if constexpr(std::is_same_v<std::remove_cvref_t<T>, bool>){
                 int result_tmp = 0;
@@ -131,20 +146,85 @@ namespace arcxx {
         }
     }
 
+    namespace PostgreSQL::detail {
+        [[nodiscard]] inline bool has_rows_status(const ExecStatusType status) noexcept {
+            #ifdef LIBPQ_HAS_CHUNK_MODE
+            if(status == PGRES_TUPLES_CHUNK) return true;
+            #endif
+            return status == PGRES_TUPLES_OK || status == PGRES_SINGLE_TUPLE;
+        }
+        // a part of streaming rows, which is followed by other results
+        [[nodiscard]] inline bool is_partial_rows_status(const ExecStatusType status) noexcept {
+            #ifdef LIBPQ_HAS_CHUNK_MODE
+            if(status == PGRES_TUPLES_CHUNK) return true;
+            #endif
+            return status == PGRES_SINGLE_TUPLE;
+        }
+
+        // Append a column of all rows of the result to the column of a columnar_result.
+        // Returns false if a value which is not NULL cannot be decoded.
+        template<is_attribute Attr>
+        [[nodiscard]] inline bool append_column(::PGresult* res, const int field, column<Attr>& col) {
+            using value_type = typename Attr::value_type;
+            const int rows = PQntuples(res);
+            for(int row = 0; row < rows; ++row) {
+                if(PQgetisnull(res, row, field)) {
+                    col.push_null();
+                }
+                else if constexpr(std::integral<value_type> || std::floating_point<value_type>) {
+                    const auto number = row_view{ res, row }.number<value_type>(static_cast<std::size_t>(field));
+                    if(!number) return false;
+                    col.push_back(number.value());
+                }
+                else {
+                    Attr attr{};
+                    if(!arcxx::detail::set_column_data(res, row, field, attr)) return false;
+                    col.push_back(std::move(attr));
+                }
+            }
+            return true;
+        }
+    }
+
     template<typename ResultType>
-    inline postgresql_connector::executer<ResultType>::iterator::iterator(::PGresult* pg_r)
-    : pg_result{pg_r},
-    latest_result{PQresultStatus(pg_r)},
-    pq_tuples_count{[pg_r, res = this->latest_result]{
-        if(pg_r == nullptr || res != PGRES_TUPLES_OK) return 1; // error message
-        else return PQntuples(pg_r);
-    }()},
+    inline postgresql_connector::executer<ResultType>::iterator::iterator(::PGresult* pg_r, ::PGconn* stream)
+    : pg_result{nullptr},
+    latest_result{PGRES_EMPTY_QUERY},
+    pq_tuples_count{0},
     pq_current_tuple{0},
-    buffer{}{
+    buffer{},
+    stream_conn{stream}{
+        set_result(pg_r);
+        receive();
     }
     template<typename ResultType>
     inline postgresql_connector::executer<ResultType>::iterator::~iterator(){
         if(pg_result != nullptr) PQclear(pg_result);
+        // Remaining rows are received and discarded. Cancel request would abort the transaction.
+        if(stream_conn != nullptr) {
+            while(::PGresult* res = PQgetResult(stream_conn)) PQclear(res);
+        }
+    }
+    template<typename ResultType>
+    inline void postgresql_connector::executer<ResultType>::iterator::set_result(::PGresult* pg_r){
+        pg_result = pg_r;
+        latest_result = PQresultStatus(pg_r);
+        if(pg_r == nullptr || !PostgreSQL::detail::has_rows_status(latest_result)) pq_tuples_count = 1; // error message
+        else pq_tuples_count = PQntuples(pg_r);
+        pq_current_tuple = 0;
+    }
+    template<typename ResultType>
+    inline void postgresql_connector::executer<ResultType>::iterator::receive(){
+        if(stream_conn == nullptr) return;
+        while(pq_current_tuple >= pq_tuples_count && PostgreSQL::detail::is_partial_rows_status(latest_result)) {
+            PQclear(pg_result);
+            set_result(PQgetResult(stream_conn));
+        }
+        if(!PostgreSQL::detail::is_partial_rows_status(latest_result)) {
+            // the last result is followed by nullptr
+            while(::PGresult* res = PQgetResult(stream_conn)) PQclear(res);
+            stream_conn = nullptr;
+        }
     }
     template<typename ResultType>
     inline bool postgresql_connector::executer<ResultType>::iterator::operator==(sentinel){
@@ -152,11 +232,15 @@ namespace arcxx {
     }
     template<typename ResultType>
     inline arcxx::expected<std::reference_wrapper<const ResultType>, arcxx::string> postgresql_connector::executer<ResultType>::iterator::operator*(){
-        if(latest_result != PGRES_TUPLES_OK){
+        if(!PostgreSQL::detail::has_rows_status(latest_result)){
             return arcxx::make_unexpected(PQresultErrorMessage(pg_result));
         }
         else{
-            if constexpr(is_model<ResultType>){
+            if constexpr(std::same_as<ResultType, PostgreSQL::row_view>){
+                // columns are read by the view
+                buffer = PostgreSQL::row_view{ pg_result, pq_current_tuple };
+            }
+            else if constexpr(is_model<ResultType>){
                 tuptup::indexed_apply_each(
                     [this]<std::size_t N, typename Attr>(Attr& attr){ detail::set_column_data(this->pg_result, this->pq_current_tuple, N, attr); },
                     buffer.attributes_as_tuple()
@@ -191,6 +275,7 @@ namespace arcxx {
     template<typename ResultType>
     inline postgresql_connector::executer<ResultType>::iterator& postgresql_connector::executer<ResultType>::iterator::operator++(){
         ++pq_current_tuple;
+        receive();
         return *this;
     }
 }
\ No newline at end of file
@@ -0,0 +1,208 @@
+#pragma once
+/*
+ * ARCXX: https://github.com/akisute514/arcxx
+ * Copyright (c) 2021 akisute514
+ *
+ * Released under the MIT License.
+ */
+#include <deque>
+#include <memory>
+
+#ifdef LIBPQ_HAS_PIPELINING
+namespace arcxx::PostgreSQL {
+    /*
+     * Scope of pipeline mode of a connection (libpq 14 or later).
+     * Pushed queries are sent without waiting for results of preceding ones, and their results are received in order.
+     * Each query is followed by a synchronization point, so that an error of a query does not abort following ones.
+     * The connection can not execute other queries until the pipeline is destroyed.
+     */
+    class pipeline {
+    public:
+        template<typename Result>
+        class future {
+        private:
+            friend class pipeline;
+            pipeline* owner;
+            std::shared_ptr<std::optional<arcxx::expected<Result, arcxx::string>>> value;
+
+            explicit future(pipeline* p);
+        public:
+            // Receive results of the pipeline until the result of this query is received.
+            [[nodiscard]] arcxx::expected<Result, arcxx::string>& get();
+            [[nodiscard]] bool ready() const noexcept;
+        };
+
+    private:
+        struct pending {
+            // SQL of the statement prepared in the pipeline, which is removed from the statement cache if it fails
+            std::optional<arcxx::string> prepared_sql;
+            // takes the result of the query
+            std::function<void(::PGresult*)> set_result;
+        };
+
+        postgresql_connector& connector;
+        std::optional<arcxx::string> error_msg = std::nullopt;
+        std::deque<pending> pendings;
+        // names of statements evicted from the statement cache, which are deallocated after exiting pipeline mode.
+        // DEALLOCATE in the pipeline would be aborted by an error of a query of the same synchronization point.
+        std::vector<arcxx::string> evicted_statements;
+
+        void send(const arcxx::string_view sql, const int param_count, const ::Oid* param_types, const char* const* param_values, const int* param_length, const int* param_formats, std::function<void(::PGresult*)>&& set_result);
+        // Receive the result of the oldest pending query. Returns false if there is no pending query.
+        bool receive_one();
+    public:
+        explicit pipeline(postgresql_connector& conn);
+        pipeline(const pipeline&) = delete;
+        pipeline(pipeline&&) = delete;
+        // Receive all pending results, exit pipeline mode and deallocate evicted statements.
+        ~pipeline();
+
+        bool has_error() const noexcept;
+        const arcxx::string& error_message() const;
+
+        template<typename Result, specialized_from<std::tuple> BindAttrs>
+        [[nodiscard]] future<Result> push(const query_relation<Result, BindAttrs>& query);
+
+        // Receive results of all pushed queries.
+        void receive();
+        // number of queries whose results are not received
+        std::size_t pending_count() const noexcept;
+    };
+
+    template<typename Result>
+    inline pipeline::future<Result>::future(pipeline* p)
+        : owner(p), value(std::make_shared<std::optional<arcxx::expected<Result, arcxx::string>>>()) {
+    }
+    template<typename Result>
+    inline arcxx::expected<Result, arcxx::string>& pipeline::future<Result>::get() {
+        // results are received by the destructor of the pipeline
+        while(!value->has_value() && owner->receive_one());
+        return value->value();
+    }
+    template<typename Result>
+    inline bool pipeline::future<Result>::ready() const noexcept {
+        return value->has_value();
+    }
+
+    inline pipeline::pipeline(postgresql_connector& conn) : connector(conn) {
+        if(PQenterPipelineMode(connector.conn) == 0) {
+            error_msg = arcxx::string{ "failed to enter pipeline mode. " } + PQerrorMessage(connector.conn);
+        }
+    }
+    inline pipeline::~pipeline() {
+        if(error_msg) return;
+        receive();
+        PQexitPipelineMode(connector.conn);
+        for(const auto& statement_name : evicted_statements) connector.deallocate(statement_name);
+    }
+
+    inline bool pipeline::has_error() const noexcept {
+        return static_cast<bool>(error_msg);
+    }
+    inline const arcxx::string& pipeline::error_message() const {
+        return error_msg.value();
+    }
+
+    template<typename Result, specialized_from<std::tuple> BindAttrs>
+    inline auto pipeline::push(const query_relation<Result, BindAttrs>& query) -> future<Result> {
+        future<Result> ret{ this };
+        if(error_msg) {
+            ret.value->emplace(arcxx::make_unexpected(error_msg.value()));
+            return ret;
+        }
+        postgresql_connector::with_parameters(query, [this, &ret](const auto& sql, const int param_count, const ::Oid* param_types, const char* const* param_values, const int* param_length, const int* param_formats) {
+            send(sql, param_count, param_types, param_values, param_length, param_formats,
+                [value = ret.value](::PGresult* result){ value->emplace(postgresql_connector::decode_result<Result>(result)); }
+            );
+        });
+        return ret;
+    }
+
+    inline void pipeline::send(const arcxx::string_view sql, const int param_count, const ::Oid* param_types, const char* const* param_values, const int* param_length, const int* param_formats, std::function<void(::PGresult*)>&& set_result) {
+        ::PGconn* const conn = connector.conn;
+        auto& statements = connector.statements;
+        pending query{ std::nullopt, std::move(set_result) };
+
+        const arcxx::string* name = statements.capacity() != 0 ? statements.find(sql) : nullptr;
+        if(name == nullptr && statements.capacity() != 0) {
+            const auto& inserted = statements.insert(sql, arcxx::string{ "arcxx_" } + std::to_string(++connector.prepared_count).c_str());
+            if(PQsendPrepare(conn, inserted.statement.c_str(), inserted.sql.c_str(), param_count, param_types) == 0) {
+                static_cast<void>(statements.erase(sql));
+                query.set_result(PQmakeEmptyPGresult(conn, PGRES_FATAL_ERROR));
+                return;
+            }
+            query.prepared_sql = inserted.sql;
+            name = &inserted.statement;
+        }
+
+        const int sent = (name == nullptr)
+            ? PQsendQueryParams(conn, sql.data(), param_count, param_types, param_values, param_length, param_formats, connector.result_format)
+            : PQsendQueryPrepared(conn, name->c_str(), param_count, param_values, param_length, param_formats, connector.result_format);
+        if(sent == 0) {
+            // the result has the error message of the connection
+            query.set_result(PQmakeEmptyPGresult(conn, PGRES_FATAL_ERROR));
+            if(!query.prepared_sql) return;
+            // the result of preparing is still received
+            query.set_result = [](::PGresult* result){ PQclear(result); };
+        }
+
+        while(auto evicted = statements.pop_overflow()) {
+            evicted_statements.push_back(std::move(evicted).value());
+        }
+        #ifdef LIBPQ_HAS_SEND_PIPELINE_SYNC
+        // It does not flush, so that multiple queries are sent together.
+        PQsendPipelineSync(conn);
+        #else
+        PQpipelineSync(conn);
+        #endif
+        pendings.push_back(std::move(query));
+    }
+
+    inline bool pipeline::receive_one() {
+        if(pendings.empty()) return false;
+        ::PGconn* const conn = connector.conn;
+        auto query = std::move(pendings.front());
+        pendings.pop_front();
+        PQflush(conn);
+
+        // Results until the synchronization point. Each result of a query is followed by nullptr,
+        // and two consecutive nullptr means that the connection has no more result (e.g. it is broken).
+        std::vector<::PGresult*> results;
+        bool end_of_query = false;
+        while(true) {
+            ::PGresult* const result = PQgetResult(conn);
+            if(result == nullptr) {
+                if(end_of_query) break;
+                end_of_query = true;
+                continue;
+            }
+            end_of_query = false;
+            if(PQresultStatus(result) == PGRES_PIPELINE_SYNC) {
+                PQclear(result);
+                break;
+            }
+            results.push_back(result);
+        }
+
+        std::size_t index = 0;
+        if(query.prepared_sql) {
+            if(!results.empty() && PQresultStatus(results.front()) != PGRES_COMMAND_OK) {
+                // the query is aborted and the error of preparing is the result
+                static_cast<void>(connector.statements.erase(query.prepared_sql.value()));
+            }
+            else index = 1;
+        }
+        ::PGresult* const result = index < results.size() ? std::exchange(results[index], nullptr) : PQmakeEmptyPGresult(conn, PGRES_FATAL_ERROR);
+        for(::PGresult* const discarded : results) PQclear(discarded);
+        query.set_result(result);
+        return true;
+    }
+
+    inline void pipeline::receive() {
+        while(receive_one());
+    }
+    inline std::size_t pipeline::pending_count() const noexcept {
+        return pendings.size();
+    }
+}
+#endif
@@ -0,0 +1,130 @@
+#pragma once
+/*
+ * ARCXX: https://github.com/akisute514/arcxx
+ * Copyright (c) 2021 akisute514
+ *
+ * Released under the MIT License.
+ */
+#include <libpq-fe.h>
+#include "utils.hpp"
+
+namespace arcxx::PostgreSQL {
+    /*
+     * Columns of a row of PGresult, which refer to the buffer of the result without copying.
+     * Views are valid while the result is alive.
+     */
+    class row_view {
+    private:
+        const ::PGresult* result = nullptr;
+        int row = 0;
+    public:
+        row_view() noexcept = default;
+        row_view(const ::PGresult* res, const int row_idx) noexcept : result(res), row(row_idx) {}
+
+        // number of columns
+        std::size_t size() const noexcept {
+            return static_cast<std::size_t>(PQnfields(result));
+        }
+        arcxx::string_view name(const std::size_t idx) const noexcept {
+            const char* const name_ptr = PQfname(result, static_cast<int>(idx));
+            return name_ptr != nullptr ? arcxx::string_view{ name_ptr } : arcxx::string_view{};
+        }
+        bool is_null(const std::size_t idx) const noexcept {
+            return PQgetisnull(result, row, static_cast<int>(idx)) == 1;
+        }
+
+        // Value of the column as received, which is empty if it is NULL.
+        // It is the text in text format, and also in binary format for character types.
+        arcxx::string_view text(const std::size_t idx) const noexcept {
+            if(is_null(idx)) return {};
+            return { PQgetvalue(result, row, static_cast<int>(idx)), static_cast<std::size_t>(PQgetlength(result, row, static_cast<int>(idx))) };
+        }
+        // Bytes of the column as received, which is empty if it is NULL.
+        // bytea is decoded in binary format only, and escaped in text format.
+        std::span<const std::byte> blob(const std::size_t idx) const noexcept {
+            const auto value = text(idx);
+            return { reinterpret_cast<const std::byte*>(value.data()), value.size() };
+        }
+        // Number of the column, or nullopt if it is NULL or not a number.
+        template<typename T>
+        requires std::integral<T> || std::floating_point<T>
+        std::optional<T> number(const std::size_t idx) const noexcept {
+            if(is_null(idx)) return std::nullopt;
+            const auto field = static_cast<int>(idx);
+            const auto value = text(idx);
+            T result_value{};
+            if(PQfformat(result, field) == 1) {
+                if(!detail::from_binary(result_value, PQftype(result, field), value.data(), static_cast<int>(value.size()))) return std::nullopt;
+                return result_value;
+            }
+            if(value.empty()) return std::nullopt;
+            if constexpr(std::same_as<T, bool>) {
+                // boolean is 't' or 'f' in text format
+                return value.front() == 't' || value.front() == '1';
+            }
+            else {
+                const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), result_value);
+                if(ec != std::errc{}) return std::nullopt;
+                return result_value;
+            }
+        }
+    };
+
+    /*
+     * Rows of a query result, which owns the PGresult.
+     * Rows are accessed by index without decoding, and views of the rows are valid while the result_view is alive.
+     */
+    class result_view {
+    private:
+        ::PGresult* result;
+    public:
+        class iterator {
+        private:
+            const ::PGresult* result;
+            int row;
+        public:
+            using value_type = row_view;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() noexcept : result(nullptr), row(0) {}
+            iterator(const ::PGresult* res, const int row_idx) noexcept : result(res), row(row_idx) {}
+            row_view operator*() const noexcept { return row_view{ result, row }; }
+            iterator& operator++() noexcept { ++row; return *this; }
+            iterator operator++(int) noexcept { auto prev = *this; ++row; return prev; }
+            bool operator==(const iterator& other) const noexcept { return row == other.row; }
+        };
+
+        explicit result_view(::PGresult* res) noexcept : result(res) {}
+        result_view(const result_view&) = delete;
+        result_view(result_view&& src) noexcept : result(src.result) { src.result = nullptr; }
+        result_view& operator=(const result_view&) = delete;
+        result_view& operator=(result_view&& src) noexcept {
+            if(this != &src) {
+                if(result != nullptr) PQclear(result);
+                result = src.result;
+                src.result = nullptr;
+            }
+            return *this;
+        }
+        ~result_view() {
+            if(result != nullptr) PQclear(result);
+        }
+
+        // number of rows
+        std::size_t size() const noexcept {
+            return static_cast<std::size_t>(PQntuples(result));
+        }
+        bool empty() const noexcept {
+            return size() == 0;
+        }
+        row_view operator[](const std::size_t row) const noexcept {
+            return row_view{ result, static_cast<int>(row) };
+        }
+        iterator begin() const noexcept {
+            return iterator{ result, 0 };
+        }
+        iterator end() const noexcept {
+            return iterator{ result, PQntuples(result) };
+        }
+    };
+}
@@ -88,7 +88,7 @@ namespace arcxx::PostgreSQL {
     [[nodiscard]] inline arcxx::string column_definition() {
         return concat_strings(
             T::column_name,
-            std::is_same_v<typename T::value_type::duration, std::chrono::days> ? " TIMESTAMP" : " DATE",
+            std::is_same_v<typename T::value_type::duration, std::chrono::days> ? " DATE" : " TIMESTAMP",
             T::has_constraint(T::unique) ? " UNIQUE" : "",
             T::has_constraint(T::primary_key) ? " PRIMARY KEY" : "",
             T::has_constraint(T::not_null) ? " NOT NULL" : "",
@@ -11,6 +11,13 @@
 namespace arcxx {
     class postgresql_connector;
 
+    namespace PostgreSQL::detail {
+        // Connector which writes bound values as literals into SQL, for statements which can not have parameters (e.g. COPY)
+        struct literal_connector : public connector {
+            static constexpr bool bindable = false;
+        };
+    }
+
     inline namespace postgresql_string_convertors{
         // boolean
         template<std::same_as<postgresql_connector> Connector, is_attribute Attr>
@@ -64,32 +71,9 @@ namespace arcxx {
         template<std::same_as<postgresql_connector> Connector, is_attribute Attr>
         requires regarded_as_clock<typename Attr::value_type>
         [[nodiscard]] inline arcxx::string to_string(const Attr& attr, arcxx::string&& buff = {}) {
-            // YYYY-MM-DD hh:mm:ss (UTC or GMT)
-            using clock = Attr::value_type::clock;
-            using duration = typename Attr::value_type::duration;
-            namespace chrono = std::chrono;
-
+            // YYYY-MM-DD[ hh:mm:ss[.fffffffff]] (UTC or GMT)
             if(attr){
-                #ifdef _MSC_VER
-                using duration = typename Attr::value_type::duration;
-                if constexpr(std::is_same_v<duration, chrono::days>){
-                    std::format_to(std::back_inserter(buff),"{:%F}", attr.value());
-                }
-                else {
-                    std::format_to(std::back_inserter(buff), "{:%F %T}", chrono::floor<chrono::seconds>(attr.value()));
-                }
-                #else
-                const std::time_t t = clock::to_time_t(attr.value());
-                std::tm* gmt = std::gmtime(&t);
-                if(gmt == nullptr) throw std::runtime_error("std::gmtime causes error");
-                char str[32]{0};
-                const char* const fmt_str = [](){
-                    if constexpr(std::is_same_v<duration, chrono::days>) return "%F";
-                    else return "%F %T";
-                }();
-                if(std::strftime(str, 32, fmt_str, gmt) == 0) throw std::runtime_error("std::strftime causes error");
-                buff += str;
-                #endif
+                arcxx::detail::append_datetime(buff, attr.value());
             }
             else{
                 buff += "null";
@@ -99,34 +83,9 @@ namespace arcxx {
         template<std::same_as<postgresql_connector> Connector, is_attribute Attr>
         requires regarded_as_clock<typename Attr::value_type>
         inline void from_string(Attr& attr, const arcxx::string_view str){
-            using clock = Attr::value_type::clock;
-            using duration = typename Attr::value_type::duration;
-            namespace chrono = std::chrono;
-
             if(str == "null") attr = std::nullopt;
-            else{
-                #ifdef _MSC_VER
-                chrono::time_point<clock, duration> result;
-                std::basic_istringstream<typename arcxx::string::value_type> iss{ arcxx::string{str} };
-                if constexpr((std::is_same_v<duration, chrono::days>)){
-                    iss >> std::chrono::parse("%F", result);
-                }
-                else {
-                    iss >> std::chrono::parse("%F %T", result);
-                }
-                if (!iss) throw std::runtime_error("unavailable clock format");
-                #else
-                std::tm gmt;
-                const char* const fmt_str = [](){
-                    if constexpr(std::is_same_v<duration, chrono::days>) return "%F";
-                    else return "%F %T";
-                }();
-                if(strptime(&str.front(), fmt_str, &gmt) == &str.front()) throw std::runtime_error("unavailable clock format");
-                const time_t t = timegm(&gmt);
-                if(t == time_t(-1)) throw std::runtime_error("unavailable clock format");
-                attr = time_point_cast<duration>(clock::from_time_t(t));
-                #endif
-            }
+            else if(const auto time_point = arcxx::detail::parse_datetime<typename Attr::value_type>(str)) attr = time_point.value();
+            else throw std::runtime_error("unavailable clock format");
         }
 
         // binary
@@ -147,5 +106,46 @@ namespace arcxx {
             attr.value().reserve(str.size());
             std::copy(str.begin(), str.end(), attr.value().begin());
         }
+
+        // literal of statements without parameters
+        template<std::same_as<PostgreSQL::detail::literal_connector> Connector, is_attribute Attr>
+        [[nodiscard]] inline arcxx::string to_string(const Attr& attr, arcxx::string&& buff = {}) {
+            using value_type = typename Attr::value_type;
+            if(!attr) return std::move(buff += "NULL");
+            if constexpr(std::same_as<value_type, bool>) {
+                // boolean column is SMALLINT
+                buff += attr.value() ? "1" : "0";
+            }
+            else if constexpr(std::integral<value_type> || std::floating_point<value_type>) {
+                std::array<arcxx::string::value_type, 32> str_buff{0};
+                std::to_chars(std::to_address(str_buff.begin()), std::to_address(str_buff.end()), attr.value());
+                buff += str_buff.data();
+            }
+            else {
+                const auto text = [&attr]{
+                    if constexpr(std::same_as<value_type, arcxx::string>) return attr.value();
+                    else if constexpr(std::same_as<value_type, std::vector<std::byte>>) {
+                        // hex format of bytea
+                        constexpr arcxx::string_view digits = "0123456789abcdef";
+                        arcxx::string hex = "\\x";
+                        hex.reserve(2 + attr.value().size() * 2);
+                        for(const auto b : attr.value()) {
+                            hex += digits[std::to_integer<unsigned>(b) >> 4];
+                            hex += digits[std::to_integer<unsigned>(b) & 0xF];
+                        }
+                        return hex;
+                    }
+                    else return to_string<postgresql_connector>(attr);
+                }();
+                // escape string constant, which does not depend on standard_conforming_strings
+                buff += "E'";
+                for(const auto c : text) {
+                    if(c == '\'' || c == '\\') buff += c;
+                    buff += c;
+                }
+                buff += "'";
+            }
+            return std::move(buff);
+        }
     }
 }
\ No newline at end of file
@@ -6,22 +6,69 @@
  * Released under the MIT License.
  */
 #include <libpq-fe.h>
-#include <any>
+#include <cstring>
+#include <cstdlib>
 #include <bit>
-#if !(defined(_WIN32) || defined(_WIN64))
+#if defined(_WIN32) || defined(_WIN64)
+#include <winsock2.h>
+#else
 #include <byteswap.h>
+#include <poll.h>
 #endif
 #include "arcxx/query_impl/query_relation.hpp"
 #include "string_convertors.hpp"
 
 namespace arcxx::PostgreSQL::detail {
+    // OIDs of built-in types (pg_type)
+    namespace type_oid {
+        inline constexpr ::Oid unspecified = 0;
+        inline constexpr ::Oid boolean     = 16;
+        inline constexpr ::Oid bytea       = 17;
+        inline constexpr ::Oid name        = 19;
+        inline constexpr ::Oid int8        = 20;
+        inline constexpr ::Oid int2        = 21;
+        inline constexpr ::Oid int4        = 23;
+        inline constexpr ::Oid text        = 25;
+        inline constexpr ::Oid float4      = 700;
+        inline constexpr ::Oid float8      = 701;
+        inline constexpr ::Oid bpchar      = 1042;
+        inline constexpr ::Oid varchar     = 1043;
+        inline constexpr ::Oid date        = 1082;
+        inline constexpr ::Oid timestamp   = 1114;
+        inline constexpr ::Oid timestamptz = 1184;
+        inline constexpr ::Oid numeric     = 1700;
+    }
+
+    // Type of the bind variable, which is the column type of create_table. Strings are inferred by the server.
     template<is_attribute Attr>
-    constexpr std::size_t attribute_size([[maybe_unused]] const Attr&) noexcept { return sizeof(typename Attr::value_type); }
+    [[nodiscard]] constexpr ::Oid parameter_oid() noexcept {
+        using value_type = typename Attr::value_type;
+        if constexpr(std::same_as<value_type, arcxx::string>) return type_oid::unspecified;
+        else if constexpr(std::integral<value_type> && sizeof(value_type) == 8) return type_oid::int8;
+        else if constexpr(std::integral<value_type> && sizeof(value_type) <= 2) return type_oid::int2;
+        else if constexpr(std::integral<value_type>) return type_oid::int4;
+        else if constexpr(std::floating_point<value_type> && sizeof(value_type) >= 8) return type_oid::float8;
+        else if constexpr(std::floating_point<value_type>) return type_oid::float4;
+        else if constexpr(regarded_as_clock<value_type>) {
+            return std::is_same_v<typename value_type::duration, std::chrono::days> ? type_oid::date : type_oid::timestamp;
+        }
+        else if constexpr(std::same_as<value_type, std::vector<std::byte>>) return type_oid::bytea;
+        else return type_oid::unspecified;
+    }
+
+    // Bytes of binary format of the bind variable
     template<is_attribute Attr>
-    requires regarded_as_clock<typename Attr::value_type>
-    constexpr std::size_t attribute_size(const Attr&){ return sizeof("YYYY-MM-DD hh:mm:ss"); }
+    constexpr std::size_t attribute_size([[maybe_unused]] const Attr&) noexcept {
+        switch(parameter_oid<Attr>()) {
+            case type_oid::int2:   return 2;
+            case type_oid::int4:   return 4;
+            case type_oid::float4: return 4;
+            case type_oid::date:   return 4;
+            default:               return 8;
+        }
+    }
     template<is_attribute Attr>
-    requires std::invocable<typename Attr::value_type::size>
+    requires requires(const typename Attr::value_type& v) { v.size(); }
     constexpr std::size_t attribute_size(const Attr& attr){ return attr ? attr.value().size() : 0; }
 
     template<std::size_t Bytes> struct uint{};
@@ -29,6 +76,32 @@ namespace arcxx::PostgreSQL::detail {
     template<> struct uint<4> { using type = uint32_t; };
     template<> struct uint<8> { using type = uint64_t; };
 
+    // Wait until one of sockets is ready, or timeout_ms passes if it is not negative. Returns 0 at timeout and -1 if it fails.
+    inline int poll_sockets(std::vector<::pollfd>& sockets, const int timeout_ms = -1) noexcept {
+        #if defined(_WIN32) || defined(_WIN64)
+        return WSAPoll(sockets.data(), static_cast<ULONG>(sockets.size()), timeout_ms);
+        #else
+        return ::poll(sockets.data(), static_cast<::nfds_t>(sockets.size()), timeout_ms);
+        #endif
+    }
+
+    // connect_timeout of the connection, which may be given by PGCONNECT_TIMEOUT. nullopt is no timeout.
+    // libpq applies it to PQconnectdb only, so that callers of PQconnectPoll need to apply it.
+    [[nodiscard]] inline std::optional<std::chrono::seconds> connect_timeout(const ::PGconn* conn) {
+        ::PQconninfoOption* const options = PQconninfo(const_cast<::PGconn*>(conn));
+        if(options == nullptr) return std::nullopt;
+        std::optional<std::chrono::seconds> timeout = std::nullopt;
+        for(const auto* option = options; option->keyword != nullptr; ++option) {
+            if(std::strcmp(option->keyword, "connect_timeout") != 0 || option->val == nullptr) continue;
+            int seconds = 0;
+            const auto [ptr, ec] = std::from_chars(option->val, option->val + std::strlen(option->val), seconds);
+            // libpq waits for 2 seconds at least, and 0 or less is no timeout
+            if(ec == std::errc{} && seconds > 0) timeout = std::chrono::seconds{ std::max(seconds, 2) };
+        }
+        PQconninfoFree(options);
+        return timeout;
+    }
+
     template<std::integral T>
     [[nodiscard]] inline auto byte_swap(const T h) noexcept -> decltype(h) {
         if constexpr (std::endian::native == std::endian::little) {
@@ -41,33 +114,64 @@ namespace arcxx::PostgreSQL::detail {
             else if constexpr (sizeof(h) == sizeof(uint32_t)) return bswap_32(h);
             else if constexpr (sizeof(h) == sizeof(uint64_t)) return bswap_64(h);
             #endif
+            else return h;
         }
         else return h;
     }
 
+    // binary format is big endian
+    template<typename T>
+    requires std::integral<T> || std::floating_point<T>
+    inline void store_binary(const T value, char* const dest) noexcept {
+        const auto bits = byte_swap(std::bit_cast<typename uint<sizeof(T)>::type>(value));
+        std::memcpy(dest, &bits, sizeof(bits));
+    }
+    template<typename T>
+    requires std::integral<T> || std::floating_point<T>
+    [[nodiscard]] inline T load_binary(const char* const src) noexcept {
+        typename uint<sizeof(T)>::type bits;
+        std::memcpy(&bits, src, sizeof(bits));
+        return std::bit_cast<T>(byte_swap(bits));
+    }
+
+    // 2000-01-01, the epoch of date and timestamp
+    inline constexpr std::chrono::sys_days epoch = std::chrono::sys_days{ std::chrono::year{ 2000 } / 1 / 1 };
+
+    // Storage of a bind variable in binary format. Strings and bytea refer to the attribute.
+    using parameter_buffer = std::array<char, 8>;
+
     template<is_attribute Attr>
     requires std::same_as<typename Attr::value_type, arcxx::string>
-    [[nodiscard]] inline auto get_value_ptr(const Attr& attr, [[maybe_unused]]std::any&) {
+    [[nodiscard]] inline auto get_value_ptr(const Attr& attr, [[maybe_unused]] parameter_buffer&) {
         if (!attr) return static_cast<const char*>(nullptr);
         return attr.value().c_str();
     }
     template<is_attribute Attr>
+    requires std::same_as<typename Attr::value_type, std::vector<std::byte>>
+    [[nodiscard]] inline auto get_value_ptr(const Attr& attr, [[maybe_unused]] parameter_buffer&) {
+        if (!attr) return static_cast<const char*>(nullptr);
+        return reinterpret_cast<const char*>(attr.value().data());
+    }
+    template<is_attribute Attr>
     requires std::integral<typename Attr::value_type>
-    [[nodiscard]] inline auto get_value_ptr(const Attr& attr, [[maybe_unused]]std::any& tmp) {
+    [[nodiscard]] inline auto get_value_ptr(const Attr& attr, parameter_buffer& tmp) {
         if (!attr) return static_cast<const char*>(nullptr);
-        const auto tmp_value = byte_swap(attr.value());
-        tmp = tmp_value;
-        return reinterpret_cast<const char*>(std::any_cast<decltype(tmp_value)>(&tmp));
+        switch(parameter_oid<Attr>()) {
+            case type_oid::int2: store_binary(static_cast<std::int16_t>(attr.value()), tmp.data()); break;
+            case type_oid::int4: store_binary(static_cast<std::int32_t>(attr.value()), tmp.data()); break;
+            default:             store_binary(static_cast<std::int64_t>(attr.value()), tmp.data()); break;
+        }
+        return static_cast<const char*>(tmp.data());
     }
     template<is_attribute Attr>
     requires std::floating_point<typename Attr::value_type>
-    [[nodiscard]] inline auto get_value_ptr(const Attr& attr, [[maybe_unused]]std::any& tmp) {
+    [[nodiscard]] inline auto get_value_ptr(const Attr& attr, parameter_buffer& tmp) {
         if (!attr) return static_cast<const char*>(nullptr);
         // PostgreSQL use IEE 754
-        if constexpr(std::numeric_limits<typename Attr::value_type>::is_iec559){
-            const auto tmp_value = byte_swap(std::bit_cast<typename uint<sizeof(typename Attr::value_type)>::type>(attr.value()));
-            tmp = tmp_value;
-            return reinterpret_cast<const char*>(std::any_cast<decltype(tmp_value)>(&tmp));
+        if constexpr(std::numeric_limits<double>::is_iec559 && std::numeric_limits<float>::is_iec559){
+            if constexpr(parameter_oid<Attr>() == type_oid::float8) store_binary(static_cast<double>(attr.value()), tmp.data());
+            else store_binary(static_cast<float>(attr.value()), tmp.data());
+            return static_cast<const char*>(tmp.data());
         }
         else{
             static_assert(std::bool_constant<(Attr{},false)>{}/*lazy instantiation*/, "Buy a machine that using IEE 754 as float format!");
@@ -75,10 +179,226 @@ namespace arcxx::PostgreSQL::detail {
     }
     template<is_attribute Attr>
     requires regarded_as_clock<typename Attr::value_type>
-    [[nodiscard]] inline auto get_value_ptr(const Attr& attr, [[maybe_unused]]std::any& tmp) {
-        // YYYY-MM-DD hh:mm:ss (UTC or GMT)
+    [[nodiscard]] inline auto get_value_ptr(const Attr& attr, parameter_buffer& tmp) {
+        // date is days and timestamp is microseconds since 2000-01-01 (UTC or GMT)
+        namespace chrono = std::chrono;
         if (!attr) return static_cast<const char*>(nullptr);
-        tmp = to_string<postgresql_connector>(attr);
-        return reinterpret_cast<const char*>(std::any_cast<arcxx::string&>(tmp).c_str());
+        const auto since_epoch = attr.value().time_since_epoch() - epoch.time_since_epoch();
+        if constexpr(parameter_oid<Attr>() == type_oid::date) {
+            store_binary(static_cast<std::int32_t>(chrono::floor<chrono::days>(since_epoch).count()), tmp.data());
+        }
+        else {
+            store_binary(static_cast<std::int64_t>(chrono::floor<chrono::microseconds>(since_epoch).count()), tmp.data());
+        }
+        return static_cast<const char*>(tmp.data());
+    }
+
+    // 0 is text format, 1 is binary format
+    template<is_attribute Attr>
+    [[nodiscard]] constexpr int parameter_format() noexcept {
+        return static_cast<int>(!std::is_same_v<typename Attr::value_type, arcxx::string>);
+    }
+
+    // Cast to the column type of create_table, for bind variables whose type is not inferred from the statement
+    template<is_attribute Attr>
+    [[nodiscard]] constexpr arcxx::string_view parameter_type() noexcept {
+        using value_type = typename Attr::value_type;
+        if constexpr(std::same_as<value_type, arcxx::string>) return "::text";
+        else if constexpr(std::integral<value_type> && sizeof(value_type) == 8) return "::bigint";
+        else if constexpr(std::integral<value_type> && sizeof(value_type) <= 2) return "::smallint";
+        else if constexpr(std::integral<value_type>) return "::integer";
+        else if constexpr(std::floating_point<value_type> && sizeof(value_type) == 8) return "::double precision";
+        else if constexpr(std::floating_point<value_type>) return "::real";
+        else if constexpr(regarded_as_clock<value_type>) {
+            return std::is_same_v<typename value_type::duration, std::chrono::days> ? "::date" : "::timestamp";
+        }
+        else if constexpr(std::same_as<value_type, std::vector<std::byte>>) return "::bytea";
+        else return "";
     }
-}
\ No newline at end of file
+
+    // numeric is base 10000 digits: ndigits, weight, sign, dscale, digits...
+    [[nodiscard]] inline double numeric_to_double(const char* const src, const int length) noexcept {
+        if(length < 8) return 0;
+        const auto ndigits = load_binary<std::int16_t>(src);
+        const auto weight = load_binary<std::int16_t>(src + 2);
+        const auto sign = static_cast<std::uint16_t>(load_binary<std::int16_t>(src + 4));
+        if(sign == 0xC000) return std::numeric_limits<double>::quiet_NaN();
+        if(sign == 0xD000) return std::numeric_limits<double>::infinity();
+        if(sign == 0xF000) return -std::numeric_limits<double>::infinity();
+        double result = 0;
+        for(int i = 0; i < ndigits && 8 + i * 2 + 2 <= length; ++i) {
+            result = result * 10000 + load_binary<std::int16_t>(src + 8 + i * 2);
+        }
+        // the last digit is 10000^(weight - ndigits + 1)
+        const int exponent = weight - ndigits + 1;
+        for(int i = 0; i < exponent; ++i) result *= 10000;
+        for(int i = 0; i > exponent; --i) result /= 10000;
+        return sign == 0x4000 ? -result : result;
+    }
+
+    // Decode a value of binary format. Returns false if the column type is not convertible.
+    template<typename T>
+    requires std::integral<T> || std::floating_point<T>
+    [[nodiscard]] inline bool from_binary(T& result, const ::Oid type, const char* const src, const int length) noexcept {
+        switch(type) {
+            case type_oid::boolean: result = static_cast<T>(src[0] != 0); return true;
+            case type_oid::int2:    result = static_cast<T>(load_binary<std::int16_t>(src)); return true;
+            case type_oid::int4:    result = static_cast<T>(load_binary<std::int32_t>(src)); return true;
+            case type_oid::int8:    result = static_cast<T>(load_binary<std::int64_t>(src)); return true;
+            case type_oid::float4:  result = static_cast<T>(load_binary<float>(src)); return true;
+            case type_oid::float8:  result = static_cast<T>(load_binary<double>(src)); return true;
+            case type_oid::numeric: result = static_cast<T>(numeric_to_double(src, length)); return true;
+            default: return false;
+        }
+    }
+    template<is_attribute Attr>
+    requires std::integral<typename Attr::value_type> || std::floating_point<typename Attr::value_type>
+    [[nodiscard]] inline bool from_binary(Attr& attr, const ::Oid type, const char* const src, const int length) noexcept {
+        typename Attr::value_type tmp{};
+        if(!from_binary(tmp, type, src, length)) return false;
+        attr = tmp;
+        return true;
+    }
+    template<is_attribute Attr>
+    requires std::same_as<typename Attr::value_type, arcxx::string>
+    [[nodiscard]] inline bool from_binary(Attr& attr, const ::Oid type, const char* const src, const int length) {
+        // binary format of character types is the text itself
+        if(type != type_oid::text && type != type_oid::varchar && type != type_oid::bpchar && type != type_oid::name) return false;
+        attr = arcxx::string{ src, static_cast<std::size_t>(length) };
+        return true;
+    }
+    template<is_attribute Attr>
+    requires std::same_as<typename Attr::value_type, std::vector<std::byte>>
+    [[nodiscard]] inline bool from_binary(Attr& attr, const ::Oid type, const char* const src, const int length) {
+        if(type != type_oid::bytea) return false;
+        const auto* const bytes = reinterpret_cast<const std::byte*>(src);
+        attr = std::vector<std::byte>(bytes, bytes + length);
+        return true;
+    }
+    template<is_attribute Attr>
+    requires regarded_as_clock<typename Attr::value_type>
+    [[nodiscard]] inline bool from_binary(Attr& attr, const ::Oid type, const char* const src, [[maybe_unused]] const int length) noexcept {
+        namespace chrono = std::chrono;
+        using value_type = typename Attr::value_type;
+        using duration = typename value_type::duration;
+        if(type == type_oid::timestamp || type == type_oid::timestamptz) {
+            const auto since_epoch = epoch.time_since_epoch() + chrono::microseconds{ load_binary<std::int64_t>(src) };
+            attr = value_type{ chrono::floor<duration>(since_epoch) };
+        }
+        else if(type == type_oid::date) {
+            const auto since_epoch = epoch.time_since_epoch() + chrono::days{ load_binary<std::int32_t>(src) };
+            attr = value_type{ chrono::floor<duration>(since_epoch) };
+        }
+        else return false;
+        return true;
+    }
+
+    // binary COPY format
+    inline constexpr arcxx::string_view copy_signature{ "PGCOPY\n\377\r\n\0", 11 };
+    // Rows are sent by PQputCopyData when the buffer exceeds it.
+    inline constexpr std::size_t copy_chunk_size = 64 * 1024;
+
+    // Append a field of binary COPY format, which is the length (-1 is NULL) and the value in binary format.
+    template<is_attribute Attr>
+    inline void write_copy_field(arcxx::string& buff, const Attr& attr) {
+        std::array<char, 4> length;
+        if (!attr) {
+            store_binary(std::int32_t{ -1 }, length.data());
+            buff.append(length.data(), length.size());
+            return;
+        }
+        parameter_buffer tmp;
+        const char* const value = get_value_ptr(attr, tmp);
+        const std::size_t size = attribute_size(attr);
+        store_binary(static_cast<std::int32_t>(size), length.data());
+        buff.append(length.data(), length.size());
+        buff.append(value, size);
+    }
+    template<is_attribute... Attrs, typename Mod>
+    inline void write_copy_row(arcxx::string& buff, const Mod& model) {
+        std::array<char, 2> field_count;
+        store_binary(static_cast<std::int16_t>(sizeof...(Attrs)), field_count.data());
+        buff.append(field_count.data(), field_count.size());
+        const auto attributes = model.attributes_as_tuple();
+        (write_copy_field(buff, std::get<const Attrs&>(attributes)), ...);
+    }
+
+    // Type of a field of binary COPY, which does not have types of columns.
+    // Columns are supposed to be types of create_table, whose size determines the type.
+    template<is_attribute Attr>
+    [[nodiscard]] constexpr ::Oid copy_field_oid(const int length) noexcept {
+        using value_type = typename Attr::value_type;
+        if constexpr(std::same_as<value_type, arcxx::string>) return type_oid::text;
+        else if constexpr(std::same_as<value_type, std::vector<std::byte>>) return type_oid::bytea;
+        else if constexpr(std::integral<value_type>) {
+            switch(length) {
+                case 1:  return type_oid::boolean;
+                case 2:  return type_oid::int2;
+                case 4:  return type_oid::int4;
+                case 8:  return type_oid::int8;
+                default: return type_oid::unspecified;
+            }
+        }
+        else if constexpr(std::floating_point<value_type>) {
+            switch(length) {
+                case 4:  return type_oid::float4;
+                case 8:  return type_oid::float8;
+                default: return type_oid::numeric;
+            }
+        }
+        else if constexpr(regarded_as_clock<value_type>) {
+            switch(length) {
+                case 4:  return type_oid::date;
+                case 8:  return type_oid::timestamp;
+                default: return type_oid::unspecified;
+            }
+        }
+        else return type_oid::unspecified;
+    }
+
+    // Returns the position after the header of binary COPY, or nullptr if it is invalid.
+    [[nodiscard]] inline const char* read_copy_header(const char* const pos, const char* const end) noexcept {
+        // signature, flags and length of header extension
+        constexpr std::size_t fixed_size = copy_signature.size() + 8;
+        if(static_cast<std::size_t>(end - pos) < fixed_size || arcxx::string_view{ pos, copy_signature.size() } != copy_signature) return nullptr;
+        const auto extension = load_binary<std::int32_t>(pos + copy_signature.size() + 4);
+        if(extension < 0 || end - pos - fixed_size < static_cast<std::size_t>(extension)) return nullptr;
+        return pos + fixed_size + extension;
+    }
+    // Read a row of binary COPY into attributes of the model.
+    // Returns the position after the row, or nullptr if the row does not match the attributes.
+    template<is_attribute... Attrs, typename Mod>
+    [[nodiscard]] inline const char* read_copy_row(const char* pos, const char* const end, Mod& model) {
+        if(end - pos < 2 || load_binary<std::int16_t>(pos) != static_cast<std::int16_t>(sizeof...(Attrs))) return nullptr;
+        pos += 2;
+        auto attributes = model.attributes_as_tuple();
+        const auto read_field = [&pos, end]<typename Attr>(Attr& attr) {
+            if(end - pos < 4) return false;
+            const auto length = load_binary<std::int32_t>(pos);
+            pos += 4;
+            if(length < 0) {
+                attr = std::nullopt;
+                return true;
+            }
+            if(end - pos < length) return false;
+            const bool ret = from_binary(attr, copy_field_oid<Attr>(length), pos, length);
+            pos += length;
+            return ret;
+        };
+        return (read_field(std::get<Attrs&>(attributes)) && ...) ? pos : nullptr;
+    }
+
+    // type of a row which an executer of the query result yields
+    template<typename Result>
+    struct row_type {
+        using type = Result;
+    };
+    template<specialized_from<std::vector> Result>
+    struct row_type<Result> {
+        using type = typename Result::value_type;
+    };
+    template<specialized_from<std::unordered_map> Result>
+    struct row_type<Result> {
+        using type = std::pair<typename Result::key_type, typename Result::mapped_type>;
+    };
+}
@@ -8,6 +8,13 @@
 #include <libpq-fe.h>
 #include "postgresql/schema.hpp"
 #include "postgresql/utils.hpp"
+#include "postgresql/row_view.hpp"
+#include "statement_cache.hpp"
+
+#if defined(__cpp_impl_coroutine) && __has_include(<sys/epoll.h>)
+#define ARCXX_POSTGRESQL_HAS_ASYNC 1
+#include <coroutine>
+#endif
 
 namespace arcxx {
     namespace PostgreSQL {
@@ -31,18 +38,54 @@ namespace arcxx {
             const arcxx::string option;
             const arcxx::string debug_of;
         };
+
+        class pipeline;
+        #ifdef ARCXX_POSTGRESQL_HAS_ASYNC
+        template<typename Result>
+        class async_result;
+        namespace detail {
+            class async_query;
+        }
+        #endif
     }
 
     class postgresql_connector : public connector {
     private:
         ::PGconn* conn = nullptr;
-        std::optional<arcxx::string> error_msg = std::nullopt;
-
+        detail::persistent_message error_msg = std::nullopt;
+        // names of server-side prepared statements
+        detail::statement_cache<arcxx::string> statements;
+        std::size_t prepared_count = 0;
+        // 0 is text format, 1 is binary format
+        int result_format = 0;
+
+        // Call f(sql, param_count, param_types, param_values, param_length, param_formats) with parameters of the query.
+        template<typename Result, specialized_from<std::tuple> BindAttrs, typename F>
+        static auto with_parameters(const query_relation<Result, BindAttrs>& query, F&& f);
+        // If chunk_rows is not 0, the query is sent and the first chunk of rows is returned. See exec_params.
         template<typename Result, specialized_from<std::tuple> BindAttrs>
-        static PGresult* exec_sql(const query_relation<Result, BindAttrs>& query, ::PGconn* conn);
+        PGresult* exec_sql(const query_relation<Result, BindAttrs>& query, const int chunk_rows = 0);
+        // Convert rows of the result into Result. The result is cleared.
+        template<typename Result>
+        static arcxx::expected<Result, arcxx::string> decode_result(::PGresult* result);
+        // Execute a statement (null terminated) with parameters by PQexecPrepared if the statement cache is enabled.
+        // If chunk_rows is not 0, it sends the statement in single-row mode (chunked rows mode if libpq supports it)
+        // and returns the first result. Following results are received by PQgetResult.
+        PGresult* exec_params(const arcxx::string_view sql, const int param_count, const ::Oid* param_types, const char* const* param_values, const int* param_length, const int* param_formats, const int chunk_rows = 0);
+        void deallocate(const arcxx::string& statement_name);
+        // connection started by PQconnectStart
+        explicit postgresql_connector(::PGconn* started_conn);
 
         template<typename ResultType>
         class executer;
+        friend class PostgreSQL::pipeline;
+        #ifdef ARCXX_POSTGRESQL_HAS_ASYNC
+        // Send a statement (null terminated) in nonblocking mode. Statements are not prepared, but cached ones are used.
+        bool send_params(const arcxx::string_view sql, const int param_count, const ::Oid* param_types, const char* const* param_values, const int* param_length, const int* param_formats);
+        template<typename Result>
+        friend class PostgreSQL::async_result;
+        friend class PostgreSQL::detail::async_query;
+        #endif
     public:
         postgresql_connector(const PostgreSQL::endpoint& endpoint_info, const std::optional<PostgreSQL::auth>& auth_info, const std::optional<PostgreSQL::options> option);
         postgresql_connector(const arcxx::string& info);
@@ -53,17 +96,47 @@ namespace arcxx {
 
         bool has_error() const noexcept;
         const arcxx::string& error_message() const;
+        void clear_error() noexcept;
+        // whether the connection is established and not broken
+        bool connected() const noexcept;
+        // whether a transaction is open, including a failed one
+        bool in_transaction() const noexcept;
 
         static postgresql_connector open(const PostgreSQL::endpoint endpoint_info, const std::optional<PostgreSQL::auth> auth_info = std::nullopt, const std::optional<PostgreSQL::options> option = std::nullopt);
         static postgresql_connector open(const arcxx::string& connection_info);
+        // Open count connections in parallel by PQconnectStart and PQconnectPoll. Connections which fail, or are not connected in connect_timeout, have errors.
+        static std::vector<postgresql_connector> open_many(const std::size_t count, const arcxx::string& connection_info);
 
         int protocol_version() const;
         int server_version() const;
 
         void close();
+        // Reset the connection. Prepared statements are discarded.
+        arcxx::expected<void, arcxx::string> reconnect();
+
+        // Statements with bind variables are prepared on the server and cached by SQL in LRU order.
+        static constexpr std::size_t default_statement_cache_capacity = 64;
+        std::size_t statement_cache_capacity() const noexcept;
+        std::size_t statement_cache_size() const noexcept;
+        // 0 disables prepared statements. Evicted statements are deallocated.
+        void set_statement_cache_capacity(const std::size_t capacity);
+
+        static constexpr int default_chunk_rows = 1000;
+
+        // Receive results in binary format instead of text. Disabled by default.
+        void set_binary_results(const bool enable) noexcept;
+        bool binary_results() const noexcept;
 
         static constexpr bool bindable = true;
+        static constexpr arcxx::string_view bind_variable_prefix = "$";
         static arcxx::string bind_variable_str(const std::size_t idx, arcxx::string&& buff = {});
+        // maximum number of bind variables of a statement (limit of the protocol)
+        std::size_t bind_variable_limit() const noexcept;
+        // VALUES in FROM can have column names, e.g. (VALUES ...) AS v(a, b)
+        static constexpr bool derived_column_list = true;
+        // cast of bind variable whose type is not inferred from the statement
+        template<is_attribute Attr>
+        static constexpr arcxx::string_view parameter_type() noexcept;
 
         template<specialized_from<std::vector> Result, specialized_from<std::tuple> BindAttrs>
         [[nodiscard]] auto make_executer(const query_relation<Result, BindAttrs>& query) -> arcxx::expected<executer<typename Result::value_type>, arcxx::string>;
@@ -77,6 +150,19 @@ namespace arcxx {
         [[nodiscard]] auto make_executer(const query_relation<Result, BindAttrs>& query) -> arcxx::expected<executer<Result>, arcxx::string>;
         template<typename Result, specialized_from<std::tuple> BindAttrs>
         [[nodiscard]] auto make_executer(query_relation<Result, BindAttrs>&& query) -> arcxx::expected<executer<Result>, arcxx::string>;
+        // Executer which yields PostgreSQL::row_view of each row instead of decoding columns into Result.
+        template<typename Result, specialized_from<std::tuple> BindAttrs>
+        [[nodiscard]] auto make_view_executer(const query_relation<Result, BindAttrs>& query) -> arcxx::expected<executer<PostgreSQL::row_view>, arcxx::string>;
+        template<typename Result, specialized_from<std::tuple> BindAttrs>
+        [[nodiscard]] auto make_view_executer(query_relation<Result, BindAttrs>&& query) -> arcxx::expected<executer<PostgreSQL::row_view>, arcxx::string>;
+
+        // Executer which receives rows while iterating, so that only a chunk of rows is in memory.
+        // chunk_rows is used if libpq supports chunked rows mode (PostgreSQL 17), otherwise rows are received one by one.
+        // The connection can not execute other queries until the iteration ends.
+        template<specialized_from<std::vector> Result, specialized_from<std::tuple> BindAttrs>
+        [[nodiscard]] auto make_streaming_executer(const query_relation<Result, BindAttrs>& query, const int chunk_rows = default_chunk_rows) -> arcxx::expected<executer<typename Result::value_type>, arcxx::string>;
+        template<specialized_from<std::vector> Result, specialized_from<std::tuple> BindAttrs>
+        [[nodiscard]] auto make_streaming_executer(query_relation<Result, BindAttrs>&& query, const int chunk_rows = default_chunk_rows) -> arcxx::expected<executer<typename Result::value_type>, arcxx::string>;
 
         template<is_model Mod>
         arcxx::expected<void, arcxx::string> create_table(decltype(abort_if_exists));
@@ -93,6 +179,31 @@ namespace arcxx {
 
         template<specialized_from<std::tuple> BindAttrs>
         arcxx::expected<void, arcxx::string> exec(const query_relation<void, BindAttrs>& query);
+        // Execute a select and return its rows in struct-of-arrays layout.
+        template<specialized_from<std::vector> Result, specialized_from<std::tuple> BindAttrs>
+        [[nodiscard]] arcxx::expected<columnar_result_t<Result>, arcxx::string> exec_columnar(const query_relation<Result, BindAttrs>& query);
+        // Execute the query and return its rows without decoding them. Rows are accessed by index.
+        template<typename Result, specialized_from<std::tuple> BindAttrs>
+        [[nodiscard]] arcxx::expected<PostgreSQL::result_view, arcxx::string> exec_view(const query_relation<Result, BindAttrs>& query);
+        #ifdef ARCXX_POSTGRESQL_HAS_ASYNC
+        // Send the query and return an awaitable of its result. See PostgreSQL::reactor.
+        template<typename Result, specialized_from<std::tuple> BindAttrs>
+        [[nodiscard]] PostgreSQL::async_result<Result> exec_async(const query_relation<Result, BindAttrs>& query);
+        #endif
+        // Execute a statement for each chunk of rows. Returns the number of affected rows.
+        template<specialized_from<std::tuple> BindRow>
+        arcxx::expected<std::size_t, arcxx::string> exec(const multi_row_query_relation<BindRow>& query);
+
+        // Load models by COPY FROM STDIN in binary format. Attrs are the columns to copy, and all attributes if empty.
+        // Callbacks of models are not called. Returns the number of copied rows.
+        template<is_model Mod, is_attribute... Attrs, std::ranges::input_range Range>
+        requires std::same_as<std::remove_cvref_t<std::ranges::range_reference_t<Range>>, Mod> && (std::same_as<typename Attrs::model_type, Mod> && ...)
+        arcxx::expected<std::size_t, arcxx::string> copy_in(Range&& models);
+        // Export rows of the query by COPY TO STDOUT in binary format. Each row is decoded into a reused model and passed to sink,
+        // which is a callback or an output iterator. Bound values are written into SQL as literals. Returns the number of rows.
+        template<is_model Mod, typename Result, specialized_from<std::tuple> BindAttrs, typename Sink>
+        requires std::same_as<typename PostgreSQL::detail::row_type<Result>::type, Mod> && (std::invocable<Sink&, const Mod&> || std::output_iterator<Sink, const Mod&>)
+        arcxx::expected<std::size_t, arcxx::string> copy_out(const query_relation<Result, BindAttrs>& query, Sink&& sink);
 
         arcxx::expected<void, arcxx::string> begin();
         arcxx::expected<void, arcxx::string> commit();
@@ -115,4 +226,6 @@ namespace arcxx {
 }
 
 #include "postgresql/executer.ipp"
-#include "postgresql/connector.ipp"
\ No newline at end of file
+#include "postgresql/connector.ipp"
+#include "postgresql/pipeline.ipp"
+#include "postgresql/async.ipp"
\ No newline at end of file
@@ -51,6 +51,9 @@ namespace arcxx {
             if(!attr) {
                 return sqlite3_bind_null(stmt, static_cast<int>(index + 1));
             }
+            else if constexpr(sqlite3::detail::is_integer_datetime<Attr>) {
+                return sqlite3_bind_int64(stmt, static_cast<int>(index + 1), sqlite3::detail::to_epoch<Attr>(attr.value()));
+            }
             else {
                 const arcxx::string time_str = to_string<sqlite3_connector>(attr);
                 // copy text
@@ -70,7 +73,8 @@ namespace arcxx {
         }
     }
 
-    inline sqlite3_connector::sqlite3_connector(const arcxx::string& file_name, const int flags){
+    inline sqlite3_connector::sqlite3_connector(const arcxx::string& file_name, const int flags)
+        : statements(default_statement_cache_capacity) {
         auto result = sqlite3_open_v2(file_name.c_str(), &db_obj, flags, nullptr);
         if(result != SQLITE_OK) error_msg = get_error_msg(result);
     }
@@ -93,18 +97,32 @@ namespace arcxx {
     inline const arcxx::string& sqlite3_connector::error_message() const {
         return error_msg.value();
     }
+    inline void sqlite3_connector::clear_error() noexcept {
+        error_msg = std::nullopt;
+    }
+    inline bool sqlite3_connector::connected() const noexcept {
+        return db_obj != nullptr;
+    }
+    inline bool sqlite3_connector::in_transaction() const noexcept {
+        return db_obj != nullptr && sqlite3_get_autocommit(db_obj) == 0;
+    }
 
     inline sqlite3_connector sqlite3_connector::open(const arcxx::string& file_name, const int flags){
         return sqlite3_connector{ file_name, flags };
     }
     inline void sqlite3_connector::close() {
+        // statements borrowed by executers are finalized when they are released
+        for(const auto& cached : statements.clear()) {
+            if(!cached.in_use) sqlite3_finalize(cached.stmt);
+        }
         if (db_obj != nullptr){
             sqlite3_close(db_obj);
             db_obj = nullptr;
         }
     }
 
-    inline sqlite3_connector::sqlite3_connector(sqlite3_connector&& conn){
+    inline sqlite3_connector::sqlite3_connector(sqlite3_connector&& conn)
+        : statements(std::move(conn.statements)), cache_hits(conn.cache_hits), cache_misses(conn.cache_misses) {
         this->db_obj = conn.db_obj;
         conn.db_obj = nullptr;
 
@@ -126,28 +144,114 @@ namespace arcxx {
         std::array<arcxx::string::value_type, 8> char_buff{0};
         std::to_chars(std::to_address(char_buff.begin()), std::to_address(char_buff.end()), idx+1);
         buff.reserve(buff.size() + 8);
-        buff += "?";
+        buff += bind_variable_prefix;
         buff += char_buff.data();
         return std::move(buff);
     }
 
-    template<typename Result, specialized_from<std::tuple> BindAttrs>
-    inline arcxx::expected<::sqlite3_stmt*, arcxx::string> sqlite3_connector::make_stmt_and_bind(const query_relation<Result, BindAttrs>& query){
-        const auto sql = query.template to_sql<sqlite3_connector>();
+    inline std::size_t sqlite3_connector::bind_variable_limit() const {
+        return static_cast<std::size_t>(sqlite3_limit(db_obj, SQLITE_LIMIT_VARIABLE_NUMBER, -1));
+    }
+
+    inline std::size_t sqlite3_connector::statement_cache_capacity() const noexcept {
+        return statements.capacity();
+    }
+    inline std::size_t sqlite3_connector::statement_cache_size() const noexcept {
+        return statements.size();
+    }
+    inline void sqlite3_connector::set_statement_cache_capacity(const std::size_t capacity) {
+        statements.set_capacity(capacity);
+        finalize_overflowed_statements();
+    }
+    inline std::size_t sqlite3_connector::statement_cache_hits() const noexcept {
+        return cache_hits;
+    }
+    inline std::size_t sqlite3_connector::statement_cache_misses() const noexcept {
+        return cache_misses;
+    }
+
+    inline arcxx::expected<::sqlite3_stmt*, arcxx::string> sqlite3_connector::acquire_statement(const arcxx::string_view sql) {
+        const bool cache_enabled = statements.capacity() != 0;
+        auto* const cached = cache_enabled ? statements.find(sql) : nullptr;
+        if(cached != nullptr && !cached->in_use) {
+            ++cache_hits;
+            cached->in_use = true;
+            return cached->stmt;
+        }
+        if(cache_enabled) ++cache_misses;
+
         ::sqlite3_stmt* stmt = nullptr;
-        auto result_code = sqlite3_prepare_v2(
+        const auto result_code = sqlite3_prepare_v3(
             db_obj,
-            sql.c_str(),
+            sql.data(),
             static_cast<int>(sql.size()),
+            cache_enabled ? SQLITE_PREPARE_PERSISTENT : 0,
             &stmt,
             nullptr
         );
         if(result_code != SQLITE_OK){
+            sqlite3_finalize(stmt);
+            return arcxx::make_unexpected(get_error_msg(result_code).value());
+        }
+        // If the cached one is borrowed by another executer, this statement is finalized after use.
+        // A statement is looked up by sqlite3_sql() when it is released, so SQL with a tail (e.g. multiple statements) is not cached.
+        if(cache_enabled && cached == nullptr && arcxx::string_view{ sqlite3_sql(stmt) } == sql) {
+            statements.insert(sql, sqlite3::detail::cached_statement{ stmt, true });
+            finalize_overflowed_statements();
+        }
+        return stmt;
+    }
+    inline void sqlite3_connector::release_statement(::sqlite3_stmt* stmt) noexcept {
+        if(stmt == nullptr) return;
+        auto* const cached = statements.capacity() != 0 ? statements.find(sqlite3_sql(stmt)) : nullptr;
+        if(cached != nullptr && cached->stmt == stmt) {
+            sqlite3_reset(stmt);
+            // bound text and blobs are not copied (SQLITE_STATIC)
+            sqlite3_clear_bindings(stmt);
+            cached->in_use = false;
+        }
+        else {
+            sqlite3_finalize(stmt);
+        }
+    }
+    inline void sqlite3_connector::finalize_overflowed_statements() noexcept {
+        while(const auto evicted = statements.pop_overflow()) {
+            // borrowed statements are finalized when they are released
+            if(!evicted->in_use) sqlite3_finalize(evicted->stmt);
+        }
+    }
+
+    inline arcxx::expected<arcxx::string, arcxx::string> sqlite3_connector::pragma(const arcxx::string_view name) {
+        arcxx::string sql = "PRAGMA ";
+        sql += name;
+        ::sqlite3_stmt* stmt = nullptr;
+        if(const auto result_code = sqlite3_prepare_v2(db_obj, sql.c_str(), static_cast<int>(sql.size()), &stmt, nullptr); result_code != SQLITE_OK) {
+            sqlite3_finalize(stmt);
             return arcxx::make_unexpected(get_error_msg(result_code).value());
         }
+        arcxx::string value;
+        if(const auto result_code = sqlite3_step(stmt); result_code == SQLITE_ROW) {
+            if(const auto* const text = sqlite3_column_text(stmt, 0); text != nullptr) value = reinterpret_cast<const char*>(text);
+        }
+        else if(result_code != SQLITE_DONE) {
+            sqlite3_finalize(stmt);
+            return arcxx::make_unexpected(get_error_msg(result_code).value());
+        }
+        sqlite3_finalize(stmt);
+        return value;
+    }
+
+    template<typename Result, specialized_from<std::tuple> BindAttrs>
+    inline arcxx::expected<::sqlite3_stmt*, arcxx::string> sqlite3_connector::make_stmt_and_bind(const query_relation<Result, BindAttrs>& query){
+        const auto sql = query.template to_sql<sqlite3_connector>();
+        auto stmt_result = acquire_statement(sql);
+        if(!stmt_result){
+            return stmt_result;
+        }
+        ::sqlite3_stmt* const stmt = stmt_result.value();
 
         if constexpr(query.bind_attrs_count() != 0) {
-            result_code = SQLITE_OK;
+            int result_code = SQLITE_OK;
             tuptup::indexed_apply_each(
                 [stmt, &result_code]<std::size_t N, typename Attr>(const Attr& attr){
                     const auto res = arcxx::sqlite3::detail::bind_variable(stmt, N, attr);
@@ -156,7 +260,9 @@ namespace arcxx {
                 query.bind_attrs
             );
             if(result_code != SQLITE_OK){
-                return arcxx::make_unexpected(get_error_msg(result_code).value());
+                auto error = get_error_msg(result_code).value();
+                release_statement(stmt);
+                return arcxx::make_unexpected(std::move(error));
             }
         }
         return stmt;
@@ -168,7 +274,7 @@ namespace arcxx {
             error_msg = stmt_result.error();
             return arcxx::make_unexpected(std::move(stmt_result.error()));
         }
-        else return executer<typename Result::value_type>(stmt_result.value());
+        else return executer<typename Result::value_type>(stmt_result.value(), this);
     }
     template<specialized_from<std::unordered_map> Result, specialized_from<std::tuple> BindAttrs>
     inline auto sqlite3_connector::make_executer(const query_relation<Result, BindAttrs>& query) -> arcxx::expected<executer<std::pair<typename Result::key_type, typename Result::mapped_type>>, arcxx::string>{
@@ -177,7 +283,7 @@ namespace arcxx {
             error_msg = stmt_result.error();
             return arcxx::make_unexpected(std::move(stmt_result.error()));
         }
-        else return executer<std::pair<typename Result::key_type, typename Result::mapped_type>>(stmt_result.value());
+        else return executer<std::pair<typename Result::key_type, typename Result::mapped_type>>(stmt_result.value(), this);
     }
     template<typename Result, specialized_from<std::tuple> BindAttrs>
     inline auto sqlite3_connector::make_executer(const query_relation<Result, BindAttrs>& query) -> arcxx::expected<executer<Result>, arcxx::string>{
@@ -188,8 +294,49 @@ namespace arcxx {
         }
         else{
             ::sqlite3_stmt* stmt = stmt_result.value();
-            return executer<Result>(stmt);
+            return executer<Result>(stmt, this);
+        }
+    }
+    template<typename Result, specialized_from<std::tuple> BindAttrs>
+    inline auto sqlite3_connector::make_view_executer(const query_relation<Result, BindAttrs>& query) -> arcxx::expected<executer<sqlite3::row_view>, arcxx::string>{
+        auto stmt_result = make_stmt_and_bind(query);
+        if(!stmt_result){
+            error_msg = stmt_result.error();
+            return arcxx::make_unexpected(std::move(stmt_result.error()));
         }
+        else return executer<sqlite3::row_view>(stmt_result.value(), this);
+    }
+
+    template<specialized_from<std::vector> Result, specialized_from<std::tuple> BindAttrs>
+    inline arcxx::expected<columnar_result_t<Result>, arcxx::string> sqlite3_connector::exec_columnar(const query_relation<Result, BindAttrs>& query){
+        auto stmt_result = make_stmt_and_bind(query);
+        if(!stmt_result){
+            error_msg = stmt_result.error();
+            return arcxx::make_unexpected(std::move(stmt_result.error()));
+        }
+        ::sqlite3_stmt* stmt = stmt_result.value();
+        columnar_result_t<Result> result{};
+        // the column which cannot be decoded, if any
+        int failed_column = -1;
+        const auto append_row = [stmt, &result, &failed_column]<std::size_t... N>(std::index_sequence<N...>){
+            static_cast<void>(((sqlite3::detail::append_column(stmt, N, result.template get<N>()) || (failed_column = static_cast<int>(N), false)) && ...));
+        };
+        int status = SQLITE_ROW;
+        while(failed_column < 0 && (status = sqlite3_step(stmt)) == SQLITE_ROW){
+            append_row(std::make_index_sequence<columnar_result_t<Result>::column_count>{});
+        }
+        if(failed_column >= 0){
+            arcxx::string error = concat_strings("failed to decode column ", arcxx::string_view{ sqlite3_column_name(stmt, failed_column) }, " of the result");
+            release_statement(stmt);
+            return arcxx::make_unexpected(std::move(error));
+        }
+        if(status != SQLITE_DONE){
+            arcxx::string error{ sqlite3_errmsg(db_obj) };
+            release_statement(stmt);
+            return arcxx::make_unexpected(std::move(error));
+        }
+        release_statement(stmt);
+        return result;
     }
 
     template<typename Result, specialized_from<std::tuple> BindAttrs>
@@ -233,6 +380,151 @@ namespace arcxx {
         else return arcxx::expected<void, arcxx::string>{};
     }
 
+    template<specialized_from<std::tuple> BindRow>
+    inline arcxx::expected<std::size_t, arcxx::string> sqlite3_connector::exec(const multi_row_query_relation<BindRow>& query){
+        // Parsing a long statement is slower than binding rows to the prepared statement again,
+        // so that rows are split into short statements even if the limit is larger.
+        const std::size_t rows_per_statement = query.rows_per_statement(std::min(bind_variable_limit(), multi_row_bind_variables));
+        constexpr std::size_t row_bind_count = query.row_bind_count();
+
+        ::sqlite3_stmt* stmt = nullptr;
+        const auto fail = [this, &stmt](const int result_code) -> arcxx::expected<std::size_t, arcxx::string> {
+            error_msg = get_error_msg(result_code);
+            release_statement(stmt);
+            return arcxx::make_unexpected(error_msg.value());
+        };
+
+        arcxx::string sql;
+        std::size_t stmt_rows = 0;
+        std::size_t changes = 0;
+        for(std::size_t first = 0; first < query.rows.size(); first += rows_per_statement) {
+            const std::size_t count = std::min(rows_per_statement, query.rows.size() - first);
+            // all chunks except for the last one reuse the prepared statement
+            if(count != stmt_rows) {
+                release_statement(stmt);
+                stmt = nullptr;
+                query.template to_sql_into<sqlite3_connector>(sql, first, count);
+                auto stmt_result = acquire_statement(sql);
+                if(!stmt_result) {
+                    error_msg = std::move(stmt_result.error());
+                    return arcxx::make_unexpected(error_msg.value());
+                }
+                stmt = stmt_result.value();
+                stmt_rows = count;
+            }
+            else {
+                sqlite3_reset(stmt);
+            }
+
+            int result_code = SQLITE_OK;
+            for(std::size_t i = 0; i < count; ++i) {
+                tuptup::indexed_apply_each(
+                    [stmt, &result_code, offset = i * row_bind_count]<std::size_t N, typename Attr>(const Attr& attr){
+                        const auto res = arcxx::sqlite3::detail::bind_variable(stmt, offset + N, attr);
+                        if(res != SQLITE_OK) result_code = res;
+                    },
+                    query.rows[first + i]
+                );
+            }
+            if(result_code != SQLITE_OK) return fail(result_code);
+
+            if(result_code = sqlite3_step(stmt); result_code != SQLITE_DONE) return fail(result_code);
+            changes += static_cast<std::size_t>(sqlite3_changes(db_obj));
+        }
+        release_statement(stmt);
+        return changes;
+    }
+
+    template<is_model Mod, std::ranges::input_range Range>
+    requires std::same_as<std::remove_cvref_t<std::ranges::range_reference_t<Range>>, Mod>
+    inline arcxx::expected<std::size_t, arcxx::string> sqlite3_connector::bulk_insert(Range&& models, const sqlite3::bulk_insert_options& options){
+        // modes are changed before the transaction, since journal_mode can not be changed in a transaction
+        std::vector<std::pair<arcxx::string_view, arcxx::string>> restored_modes;
+        const auto restore_modes = [this, &restored_modes]{
+            for(const auto& [name, value] : restored_modes) {
+                static_cast<void>(pragma(arcxx::string{ name } + " = " + value));
+            }
+        };
+        for(const auto& [name, mode] : { std::pair{ arcxx::string_view{ "journal_mode" }, &options.journal_mode }, std::pair{ arcxx::string_view{ "synchronous" }, &options.synchronous } }) {
+            if(!*mode) continue;
+            auto previous = pragma(name);
+            if(previous) {
+                restored_modes.emplace_back(name, std::move(previous.value()));
+                previous = pragma(arcxx::string{ name } + " = " + mode->value());
+            }
+            if(!previous) {
+                restore_modes();
+                error_msg = std::move(previous.error());
+                return arcxx::make_unexpected(error_msg.value());
+            }
+        }
+
+        // rows are committed by this function unless it is called in a transaction
+        const bool in_transaction = sqlite3_get_autocommit(db_obj) == 0;
+        const auto sql = Mod::insert(Mod{}).template to_sql<sqlite3_connector>();
+        auto stmt_result = acquire_statement(sql);
+        if(!stmt_result) {
+            restore_modes();
+            error_msg = std::move(stmt_result.error());
+            return arcxx::make_unexpected(error_msg.value());
+        }
+        ::sqlite3_stmt* const stmt = stmt_result.value();
+
+        std::size_t inserted = 0;
+        std::size_t transaction_rows = 0;
+        std::optional<arcxx::string> error = std::nullopt;
+        const auto run = [this](const char* const query) {
+            return sqlite3_exec(db_obj, query, nullptr, nullptr, nullptr);
+        };
+        for(const Mod& model : models) {
+            if(!in_transaction && transaction_rows == 0) {
+                if(const auto result_code = run("BEGIN;"); result_code != SQLITE_OK) {
+                    error = get_error_msg(result_code);
+                    break;
+                }
+            }
+
+            int result_code = SQLITE_OK;
+            tuptup::indexed_apply_each(
+                [stmt, &result_code]<std::size_t N, typename Attr>(const Attr& attr){
+                    const auto res = arcxx::sqlite3::detail::bind_variable(stmt, N, attr);
+                    if(res != SQLITE_OK) result_code = res;
+                },
+                model.attributes_as_tuple()
+            );
+            if(result_code == SQLITE_OK) result_code = sqlite3_step(stmt);
+            sqlite3_reset(stmt);
+            if(result_code != SQLITE_DONE) {
+                error = get_error_msg(result_code);
+                break;
+            }
+            ++inserted;
+
+            if(!in_transaction && ++transaction_rows == options.rows_per_transaction) {
+                if(const auto commit_code = run("COMMIT;"); commit_code != SQLITE_OK) {
+                    error = get_error_msg(commit_code);
+                    break;
+                }
+                transaction_rows = 0;
+            }
+        }
+        if(!in_transaction && transaction_rows != 0) {
+            if(error) run("ROLLBACK;");
+            else if(const auto result_code = run("COMMIT;"); result_code != SQLITE_OK) {
+                error = get_error_msg(result_code);
+                run("ROLLBACK;");
+            }
+        }
+        release_statement(stmt);
+        restore_modes();
+
+        if(error) {
+            error_msg = std::move(error);
+            return arcxx::make_unexpected(error_msg.value());
+        }
+        return inserted;
+    }
+
     template<is_model Mod>
     inline arcxx::expected<void, arcxx::string> sqlite3_connector::create_table(decltype(abort_if_exists)){
         return exec(raw_query<void>(Mod::schema::template to_sql<sqlite3_connector>(abort_if_exists)));
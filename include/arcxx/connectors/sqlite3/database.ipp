@@ -0,0 +1,168 @@
+#pragma once
+/*
+ * ARCXX: https://github.com/akisute514/arcxx
+ * Copyright (c) 2021 akisute514
+ *
+ * Released under the MIT License.
+ */
+#include <mutex>
+#include "../connection_pool.hpp"
+
+namespace arcxx::sqlite3 {
+    struct database_options {
+        // number of read-only connections
+        std::size_t readers = 4;
+        // flags of the writer connection
+        int flags = options::create;
+        // how long a connection waits for a lock of the database
+        std::chrono::milliseconds busy_timeout = std::chrono::seconds{ 5 };
+        // PRAGMA synchronous of the writer. NORMAL does not lose consistency in WAL mode.
+        std::optional<arcxx::string> synchronous = "NORMAL";
+        // how long a select waits for a reader when all of them are used
+        std::chrono::milliseconds checkout_timeout = std::chrono::seconds{ 30 };
+    };
+
+    /*
+     * Database file shared by threads in WAL mode.
+     * Statements without results (query_relation<void, ...>) and multi-row statements are executed by the writer connection,
+     * and selects are executed by one of read-only connections, so that reads run in parallel with each other and with a write.
+     * Connections are opened with SQLITE_OPEN_NOMUTEX, since each one is used by a thread at a time.
+     * The database must be a file, because in-memory databases are not shared by connections.
+     */
+    class database : public arcxx::connector {
+    private:
+        sqlite3_connector writer;
+        std::mutex writer_mtx;
+        connection_pool<sqlite3_connector> readers;
+        arcxx::detail::persistent_message error_msg = std::nullopt;
+
+        static arcxx::expected<void, arcxx::string> set_busy_timeout(sqlite3_connector& conn, const std::chrono::milliseconds timeout);
+    public:
+        database(const arcxx::string& file_name, const database_options& options = {});
+        database(const database&) = delete;
+        database(database&&) = delete;
+        ~database() = default;
+
+        static database open(const arcxx::string& file_name, const database_options& options = {});
+
+        // error of opening connections
+        bool has_error() const noexcept;
+        const arcxx::string& error_message() const;
+
+        template<typename Result, specialized_from<std::tuple> BindAttrs>
+        [[nodiscard]] arcxx::expected<Result, arcxx::string> exec(const query_relation<Result, BindAttrs>& query);
+        template<specialized_from<std::tuple> BindAttrs>
+        arcxx::expected<void, arcxx::string> exec(const query_relation<void, BindAttrs>& query);
+        template<specialized_from<std::tuple> BindRow>
+        arcxx::expected<std::size_t, arcxx::string> exec(const multi_row_query_relation<BindRow>& query);
+
+        template<is_model Mod>
+        arcxx::expected<void, arcxx::string> create_table(decltype(abort_if_exists));
+        template<is_model Mod>
+        arcxx::expected<void, arcxx::string> create_table();
+        template<is_model Mod>
+        arcxx::expected<void, arcxx::string> drop_table();
+
+        // Call func(writer) while other threads do not write. Selects in func see uncommitted rows of the writer.
+        template<typename F>
+        requires std::invocable<F, sqlite3_connector&>
+        auto write(F&& func);
+        // Run a transaction on the writer, as well as sqlite3_connector::transaction.
+        template<typename F>
+        requires std::convertible_to<F, std::function<transaction::detail::commit_or_rollback_t(sqlite3_connector&)>>
+        arcxx::expected<void, arcxx::string> transaction(F&& func);
+        // Check out a reader, e.g. for executers which read rows lazily.
+        [[nodiscard]] auto reader() -> arcxx::expected<connection_pool<sqlite3_connector>::handle, arcxx::string>;
+    };
+
+    inline database::database(const arcxx::string& file_name, const database_options& db_options)
+        : writer(file_name, db_options.flags | options::no_mutex),
+          readers(
+              { .min_size = std::max(db_options.readers, std::size_t{ 1 }), .max_size = std::max(db_options.readers, std::size_t{ 1 }), .lazy = true, .checkout_timeout = db_options.checkout_timeout },
+              [file_name, timeout = db_options.busy_timeout]{
+                  sqlite3_connector conn{ file_name, options::readonly | options::no_mutex };
+                  if(!conn.has_error()) static_cast<void>(set_busy_timeout(conn, timeout));
+                  return conn;
+              }
+          ) {
+        if(writer.has_error()) {
+            error_msg = writer.error_message();
+            return;
+        }
+        // WAL mode is persistent in the database file, so that readers use it too
+        auto result = set_busy_timeout(writer, db_options.busy_timeout)
+            .and_then([this]{ return writer.pragma("journal_mode = WAL"); })
+            .and_then([this, &db_options](const arcxx::string& mode) -> arcxx::expected<void, arcxx::string> {
+                if(mode != "wal") return arcxx::make_unexpected("failed to change journal_mode to WAL: " + mode);
+                if(db_options.synchronous) return writer.pragma("synchronous = " + db_options.synchronous.value()).map([](auto&&){});
+                return {};
+            })
+            .and_then([this]{ return readers.warm_up(); });
+        if(!result) error_msg = std::move(result.error());
+    }
+
+    inline database database::open(const arcxx::string& file_name, const database_options& db_options) {
+        return database{ file_name, db_options };
+    }
+
+    inline bool database::has_error() const noexcept {
+        return static_cast<bool>(error_msg);
+    }
+    inline const arcxx::string& database::error_message() const {
+        return error_msg.value();
+    }
+
+    inline arcxx::expected<void, arcxx::string> database::set_busy_timeout(sqlite3_connector& conn, const std::chrono::milliseconds timeout) {
+        return conn.pragma("busy_timeout = " + std::to_string(timeout.count())).map([](auto&&){});
+    }
+
+    template<typename Result, specialized_from<std::tuple> BindAttrs>
+    inline arcxx::expected<Result, arcxx::string> database::exec(const query_relation<Result, BindAttrs>& query) {
+        auto conn = readers.checkout();
+        if(!conn) return arcxx::make_unexpected(std::move(conn.error()));
+        return conn.value()->exec(query);
+    }
+    template<specialized_from<std::tuple> BindAttrs>
+    inline arcxx::expected<void, arcxx::string> database::exec(const query_relation<void, BindAttrs>& query) {
+        std::lock_guard lock{ writer_mtx };
+        return writer.exec(query);
+    }
+    template<specialized_from<std::tuple> BindRow>
+    inline arcxx::expected<std::size_t, arcxx::string> database::exec(const multi_row_query_relation<BindRow>& query) {
+        std::lock_guard lock{ writer_mtx };
+        return writer.exec(query);
+    }
+
+    template<is_model Mod>
+    inline arcxx::expected<void, arcxx::string> database::create_table(decltype(abort_if_exists)) {
+        std::lock_guard lock{ writer_mtx };
+        return writer.create_table<Mod>(abort_if_exists);
+    }
+    template<is_model Mod>
+    inline arcxx::expected<void, arcxx::string> database::create_table() {
+        std::lock_guard lock{ writer_mtx };
+        return writer.create_table<Mod>();
+    }
+    template<is_model Mod>
+    inline arcxx::expected<void, arcxx::string> database::drop_table() {
+        std::lock_guard lock{ writer_mtx };
+        return writer.drop_table<Mod>();
+    }
+
+    template<typename F>
+    requires std::invocable<F, sqlite3_connector&>
+    inline auto database::write(F&& func) {
+        std::lock_guard lock{ writer_mtx };
+        return std::invoke(std::forward<F>(func), writer);
+    }
+    template<typename F>
+    requires std::convertible_to<F, std::function<transaction::detail::commit_or_rollback_t(sqlite3_connector&)>>
+    inline arcxx::expected<void, arcxx::string> database::transaction(F&& func) {
+        std::lock_guard lock{ writer_mtx };
+        return writer.transaction(std::forward<F>(func));
+    }
+
+    inline auto database::reader() -> arcxx::expected<connection_pool<sqlite3_connector>::handle, arcxx::string> {
+        return readers.checkout();
+    }
+}
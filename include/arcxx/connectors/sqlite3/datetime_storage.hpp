@@ -0,0 +1,62 @@
+#pragma once
+/*
+ * ARCXX: https://github.com/akisute514/arcxx
+ * Copyright (c) 2021 akisute514
+ *
+ * Released under the MIT License.
+ */
+#include "../../attributes/attributes.hpp"
+
+namespace arcxx::sqlite3 {
+    /*
+     * Column type of datetime attributes.
+     * text is ISO 8601 (YYYY-MM-DD hh:mm:ss), and the others are INTEGER since the Unix epoch,
+     * which are bound and read without formatting and compared as integers.
+     * It is given by `datetime_storage` static member of an attribute, or of its model for all datetime attributes.
+     */
+    enum class datetime_storage {
+        text,
+        unix_seconds,
+        unix_milliseconds
+    };
+
+    namespace detail {
+        template<is_attribute Attr>
+        [[nodiscard]] constexpr datetime_storage datetime_storage_of() noexcept {
+            if constexpr(requires { { Attr::datetime_storage } -> std::convertible_to<datetime_storage>; }) {
+                return Attr::datetime_storage;
+            }
+            else if constexpr(requires { { Attr::model_type::datetime_storage } -> std::convertible_to<datetime_storage>; }) {
+                return Attr::model_type::datetime_storage;
+            }
+            else return datetime_storage::text;
+        }
+        template<is_attribute Attr>
+        inline constexpr bool is_integer_datetime = datetime_storage_of<Attr>() != datetime_storage::text;
+
+        // Integer of the column, whose unit is the storage of Attr.
+        template<is_attribute Attr>
+        requires is_integer_datetime<Attr>
+        [[nodiscard]] constexpr std::int64_t to_epoch(const typename Attr::value_type& time_point) noexcept {
+            namespace chrono = std::chrono;
+            if constexpr(datetime_storage_of<Attr>() == datetime_storage::unix_seconds) {
+                return static_cast<std::int64_t>(chrono::floor<chrono::seconds>(time_point.time_since_epoch()).count());
+            }
+            else {
+                return static_cast<std::int64_t>(chrono::floor<chrono::milliseconds>(time_point.time_since_epoch()).count());
+            }
+        }
+        template<is_attribute Attr>
+        requires is_integer_datetime<Attr>
+        [[nodiscard]] constexpr typename Attr::value_type from_epoch(const std::int64_t epoch) noexcept {
+            namespace chrono = std::chrono;
+            using value_type = typename Attr::value_type;
+            if constexpr(datetime_storage_of<Attr>() == datetime_storage::unix_seconds) {
+                return value_type{ chrono::floor<typename value_type::duration>(chrono::seconds{ epoch }) };
+            }
+            else {
+                return value_type{ chrono::floor<typename value_type::duration>(chrono::milliseconds{ epoch }) };
+            }
+        }
+    }
+}
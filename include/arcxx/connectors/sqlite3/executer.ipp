@@ -11,12 +11,14 @@ namespace arcxx {
     class sqlite3_connector::executer{
     private:
         ::sqlite3_stmt* stmt;
+        // the statement is returned to the statement cache of the connector
+        sqlite3_connector* conn;
     public:
         executer() = delete;
         executer(const executer&) = delete;
         executer(executer&&) noexcept;
 
-        executer(::sqlite3_stmt*) noexcept;
+        executer(::sqlite3_stmt*, sqlite3_connector*) noexcept;
         ~executer();
         
         struct sentinel{};
@@ -45,40 +47,46 @@ namespace arcxx {
     class sqlite3_connector::executer<void>{
     private:
         ::sqlite3_stmt* stmt;
+        // the statement is returned to the statement cache of the connector
+        sqlite3_connector* conn;
     public:
         executer() = delete;
         executer(const executer&) = delete;
         executer(executer&&) noexcept;
 
-        executer(::sqlite3_stmt*) noexcept;
+        executer(::sqlite3_stmt*, sqlite3_connector*) noexcept;
         ~executer();
 
         arcxx::expected<void, arcxx::string> execute();
     };
 
     template<typename ResultType>
-    inline sqlite3_connector::executer<ResultType>::executer(::sqlite3_stmt* s) noexcept {
+    inline sqlite3_connector::executer<ResultType>::executer(::sqlite3_stmt* s, sqlite3_connector* c) noexcept {
         stmt = s;
+        conn = c;
     }
     template<typename ResultType>
     inline sqlite3_connector::executer<ResultType>::executer(executer<ResultType>&& src) noexcept {
         stmt = src.stmt;
+        conn = src.conn;
         src.stmt = nullptr;
     }
     template<typename ResultType>
     inline sqlite3_connector::executer<ResultType>::~executer(){
-        sqlite3_finalize(stmt);
+        conn->release_statement(stmt);
     }
 
-    inline sqlite3_connector::executer<void>::executer(::sqlite3_stmt* s) noexcept {
+    inline sqlite3_connector::executer<void>::executer(::sqlite3_stmt* s, sqlite3_connector* c) noexcept {
         stmt = s;
+        conn = c;
     }
     inline sqlite3_connector::executer<void>::executer(executer<void>&& src) noexcept {
         stmt = src.stmt;
+        conn = src.conn;
         src.stmt = nullptr;
     }
     inline sqlite3_connector::executer<void>::~executer(){
-        sqlite3_finalize(stmt);
+        conn->release_statement(stmt);
     }
     inline arcxx::expected<void, arcxx::string> sqlite3_connector::executer<void>::execute(){
         const auto status = sqlite3_step(stmt);
@@ -190,9 +198,16 @@ namespace arcxx {
         requires regarded_as_clock<typename Attr::value_type>
         inline bool set_column_data(sqlite3_stmt* stmt, const std::size_t idx, Attr& attr){
             const auto type = sqlite3_column_type(stmt, static_cast<int>(idx));
+            if constexpr(sqlite3::detail::is_integer_datetime<Attr>) {
+                if(type == SQLITE_INTEGER){
+                    attr = sqlite3::detail::from_epoch<Attr>(sqlite3_column_int64(stmt, static_cast<int>(idx)));
+                    return true;
+                }
+            }
             if(type == SQLITE_TEXT){
                 auto text_ptr = sqlite3_column_text(stmt, static_cast<int>(idx));
-                from_string<sqlite3_connector>(attr, reinterpret_cast<const arcxx::string::value_type*>(text_ptr));
+                const auto length = static_cast<std::size_t>(sqlite3_column_bytes(stmt, static_cast<int>(idx)));
+                from_string<sqlite3_connector>(attr, arcxx::string_view{ reinterpret_cast<const arcxx::string::value_type*>(text_ptr), length });
                 return true;
             }
             else if(type == SQLITE_NULL){
@@ -246,11 +261,52 @@ namespace arcxx {
             }
             return false;
         }
+
+        // Append the column of the current row to the column of a columnar_result.
+        // Returns false if the value is not NULL and its type does not match the attribute, like set_column_data.
+        template<is_attribute Attr>
+        [[nodiscard]] inline bool append_column(sqlite3_stmt* stmt, const std::size_t idx, column<Attr>& col){
+            using value_type = typename Attr::value_type;
+            const auto type = sqlite3_column_type(stmt, static_cast<int>(idx));
+            if(type == SQLITE_NULL){
+                col.push_null();
+            }
+            else if constexpr(std::integral<value_type>){
+                if(type != SQLITE_INTEGER) return false;
+                col.push_back(static_cast<value_type>(sqlite3_column_int64(stmt, static_cast<int>(idx))));
+            }
+            else if constexpr(std::floating_point<value_type>){
+                if(type != SQLITE_FLOAT) return false;
+                col.push_back(static_cast<value_type>(sqlite3_column_double(stmt, static_cast<int>(idx))));
+            }
+            else if constexpr(std::same_as<value_type, arcxx::string>){
+                if(type != SQLITE_TEXT) return false;
+                const auto text_ptr = sqlite3_column_text(stmt, static_cast<int>(idx));
+                const auto size = static_cast<std::size_t>(sqlite3_column_bytes(stmt, static_cast<int>(idx)));
+                col.push_back(arcxx::string{ reinterpret_cast<const arcxx::string::value_type*>(text_ptr), size });
+            }
+            else if constexpr(std::same_as<value_type, std::vector<std::byte>>){
+                if(type != SQLITE_BLOB) return false;
+                const auto blob_ptr = static_cast<const std::byte*>(sqlite3_column_blob(stmt, static_cast<int>(idx)));
+                const auto size = static_cast<std::size_t>(sqlite3_column_bytes(stmt, static_cast<int>(idx)));
+                col.push_back(std::vector<std::byte>(blob_ptr, blob_ptr + size));
+            }
+            else{
+                Attr attr{};
+                if(!set_column_data(stmt, idx, attr)) return false;
+                col.push_back(std::move(attr));
+            }
+            return true;
+        }
     }
 
     template<typename ResultType>
     inline void sqlite3_connector::executer<ResultType>::iterator::extract_column_data(){
-        if constexpr(is_model<ResultType>){
+        if constexpr(std::same_as<ResultType, sqlite3::row_view>){
+            // columns are read by the view
+            buffer = sqlite3::row_view{ stmt };
+        }
+        else if constexpr(is_model<ResultType>){
             tuptup::indexed_apply_each(
                 [this]<std::size_t N, typename Attr>(Attr& attr){ sqlite3::detail::set_column_data(this->stmt, N, attr); },
                 buffer.attributes_as_tuple()
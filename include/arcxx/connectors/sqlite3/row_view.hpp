@@ -0,0 +1,59 @@
+#pragma once
+/*
+ * ARCXX: https://github.com/akisute514/arcxx
+ * Copyright (c) 2021 akisute514
+ *
+ * Released under the MIT License.
+ */
+#include <sqlite3.h>
+#include "arcxx/utils.hpp"
+
+namespace arcxx::sqlite3 {
+    /*
+     * Columns of the current row of a statement, which refer to buffers of sqlite3 without copying.
+     * Views and values taken from them are valid until the iterator of the executer is incremented.
+     */
+    class row_view {
+    private:
+        ::sqlite3_stmt* stmt = nullptr;
+    public:
+        row_view() noexcept = default;
+        explicit row_view(::sqlite3_stmt* s) noexcept : stmt(s) {}
+
+        // number of columns
+        std::size_t size() const noexcept {
+            return static_cast<std::size_t>(sqlite3_data_count(stmt));
+        }
+        arcxx::string_view name(const std::size_t idx) const noexcept {
+            const char* const name_ptr = sqlite3_column_name(stmt, static_cast<int>(idx));
+            return name_ptr != nullptr ? arcxx::string_view{ name_ptr } : arcxx::string_view{};
+        }
+        bool is_null(const std::size_t idx) const noexcept {
+            return sqlite3_column_type(stmt, static_cast<int>(idx)) == SQLITE_NULL;
+        }
+
+        // Text of the column, which is empty if it is NULL. Numbers are converted to text by sqlite3.
+        arcxx::string_view text(const std::size_t idx) const noexcept {
+            // sqlite3_column_bytes must be called after the conversion of sqlite3_column_text
+            const auto* const text_ptr = sqlite3_column_text(stmt, static_cast<int>(idx));
+            if(text_ptr == nullptr) return {};
+            const auto size = static_cast<std::size_t>(sqlite3_column_bytes(stmt, static_cast<int>(idx)));
+            return { reinterpret_cast<const arcxx::string::value_type*>(text_ptr), size };
+        }
+        // Bytes of the column, which is empty if it is NULL.
+        std::span<const std::byte> blob(const std::size_t idx) const noexcept {
+            const auto* const blob_ptr = sqlite3_column_blob(stmt, static_cast<int>(idx));
+            if(blob_ptr == nullptr) return {};
+            const auto size = static_cast<std::size_t>(sqlite3_column_bytes(stmt, static_cast<int>(idx)));
+            return { static_cast<const std::byte*>(blob_ptr), size };
+        }
+        // Number of the column, or nullopt if it is NULL.
+        template<typename T>
+        requires std::integral<T> || std::floating_point<T>
+        std::optional<T> number(const std::size_t idx) const noexcept {
+            if(is_null(idx)) return std::nullopt;
+            if constexpr(std::floating_point<T>) return static_cast<T>(sqlite3_column_double(stmt, static_cast<int>(idx)));
+            else return static_cast<T>(sqlite3_column_int64(stmt, static_cast<int>(idx)));
+        }
+    };
+}
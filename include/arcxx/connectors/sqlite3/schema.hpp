@@ -6,6 +6,7 @@
  * Released under the MIT License.
  */
 #include "../../attributes/attributes.hpp"
+#include "datetime_storage.hpp"
 
 namespace arcxx::sqlite3 {
     namespace detail {
@@ -86,9 +87,20 @@ namespace arcxx::sqlite3 {
     template<is_attribute T>
     requires regarded_as_clock<typename T::value_type>
     [[nodiscard]] inline arcxx::string column_definition() {
-        return concat_strings(
+        if constexpr(detail::is_integer_datetime<T>) {
+            return concat_strings(
+                T::column_name, " INTEGER",
+                T::has_constraint(T::unique) ? " UNIQUE" : "",
+                T::has_constraint(T::primary_key) ? " PRIMARY KEY" : "",
+                T::has_constraint(T::not_null) ? " NOT NULL" : "",
+                detail::reference_definition<T>()
+            );
+        }
+        else return concat_strings(
             T::column_name, " DATETIME CHECK(", T::column_name,
-            std::is_same_v<typename T::value_type::duration, std::chrono::days> ? " LIKE '____-__-__')": " LIKE '____-__-__ __:__:__')",
+            std::is_same_v<typename T::value_type::duration, std::chrono::days> ? " LIKE '____-__-__')":
+            // fraction of second follows if it is not zero
+            std::ratio_less_v<typename T::value_type::period, std::ratio<1>> ? " LIKE '____-__-__ __:__:__%')" : " LIKE '____-__-__ __:__:__')",
             T::has_constraint(T::unique) ? " UNIQUE" : "",
             T::has_constraint(T::primary_key) ? " PRIMARY KEY" : "",
             T::has_constraint(T::not_null) ? " NOT NULL" : "",
@@ -8,6 +8,8 @@
 #include <sqlite3.h>
 #include "sqlite3/schema.hpp"
 #include "sqlite3/string_convertors.hpp"
+#include "sqlite3/row_view.hpp"
+#include "statement_cache.hpp"
 
 namespace arcxx {
     namespace sqlite3 {
@@ -20,12 +22,32 @@ namespace arcxx {
             constexpr auto no_mutex   = SQLITE_OPEN_NOMUTEX;
             constexpr auto full_mutex = SQLITE_OPEN_FULLMUTEX;
         }
+
+        struct bulk_insert_options {
+            // rows committed by a transaction. 0 commits all rows at once.
+            std::size_t rows_per_transaction = 10000;
+            // PRAGMA journal_mode and synchronous while inserting (e.g. "WAL" or "MEMORY", and "OFF" or "NORMAL").
+            // Previous modes are restored after inserting.
+            std::optional<arcxx::string> journal_mode = std::nullopt;
+            std::optional<arcxx::string> synchronous = std::nullopt;
+        };
+
+        namespace detail {
+            struct cached_statement {
+                ::sqlite3_stmt* stmt;
+                // borrowed by an executer
+                bool in_use;
+            };
+        }
     }
 
     class sqlite3_connector : public connector {
     private:
         ::sqlite3* db_obj = nullptr;
-        std::optional<arcxx::string> error_msg = std::nullopt;
+        detail::persistent_message error_msg = std::nullopt;
+        detail::statement_cache<sqlite3::detail::cached_statement> statements;
+        std::size_t cache_hits = 0;
+        std::size_t cache_misses = 0;
 
         std::optional<arcxx::string> get_error_msg(const char* msg_ptr) const;
         std::optional<arcxx::string> get_error_msg(const int result_code) const;
@@ -33,6 +55,11 @@ namespace arcxx {
 
         template<typename Result, specialized_from<std::tuple> BindAttrs>
         arcxx::expected<::sqlite3_stmt*, arcxx::string> make_stmt_and_bind(const query_relation<Result, BindAttrs>& query);
+        // Borrow a prepared statement of sql from the statement cache, or prepare it.
+        arcxx::expected<::sqlite3_stmt*, arcxx::string> acquire_statement(const arcxx::string_view sql);
+        // Reset a borrowed statement and return it to the cache. Statements which are not cached are finalized.
+        void release_statement(::sqlite3_stmt* stmt) noexcept;
+        void finalize_overflowed_statements() noexcept;
 
         template<typename ResultType>
         class executer;
@@ -45,15 +72,38 @@ namespace arcxx {
 
         bool has_error() const noexcept;
         const arcxx::string& error_message() const;
+        void clear_error() noexcept;
+        // whether the database is open
+        bool connected() const noexcept;
+        bool in_transaction() const noexcept;
 
         static sqlite3_connector open(const arcxx::string& file_name, const int flags = arcxx::sqlite3::options::readwrite);
         void close();
 
         static arcxx::string_view version();
         static int version_number();
+        // Returns the result of "PRAGMA name" (or "PRAGMA name = value").
+        arcxx::expected<arcxx::string, arcxx::string> pragma(const arcxx::string_view name);
 
         static constexpr bool bindable = true;
+        static constexpr arcxx::string_view bind_variable_prefix = "?";
+        // bind variable numbered by its position. SQLite parses ?NNN in quadratic time of the number of variables.
+        static constexpr arcxx::string_view positional_bind_variable = "?";
         static arcxx::string bind_variable_str(const std::size_t idx, arcxx::string&& buff = {});
+        // maximum number of bind variables of a statement (SQLITE_LIMIT_VARIABLE_NUMBER)
+        std::size_t bind_variable_limit() const;
+        // bind variables of each statement of multi-row queries
+        static constexpr std::size_t multi_row_bind_variables = 999;
+
+        // Statements are prepared with SQLITE_PREPARE_PERSISTENT and cached by SQL in LRU order.
+        static constexpr std::size_t default_statement_cache_capacity = 64;
+        std::size_t statement_cache_capacity() const noexcept;
+        std::size_t statement_cache_size() const noexcept;
+        // 0 disables caching. Evicted statements are finalized.
+        void set_statement_cache_capacity(const std::size_t capacity);
+        // number of executions which found or did not find a cached statement
+        std::size_t statement_cache_hits() const noexcept;
+        std::size_t statement_cache_misses() const noexcept;
 
         template<specialized_from<std::vector> Result, specialized_from<std::tuple> BindAttrs>
         [[nodiscard]] auto make_executer(const query_relation<Result, BindAttrs>& query) -> arcxx::expected<executer<typename Result::value_type>, arcxx::string>;
@@ -61,11 +111,26 @@ namespace arcxx {
         [[nodiscard]] auto make_executer(const query_relation<Result, BindAttrs>& query) -> arcxx::expected<executer<std::pair<typename Result::key_type, typename Result::mapped_type>>, arcxx::string>;
         template<typename Result, specialized_from<std::tuple> BindAttrs>
         [[nodiscard]] auto make_executer(const query_relation<Result, BindAttrs>& query) -> arcxx::expected<executer<Result>, arcxx::string>;
+        // Executer which yields sqlite3::row_view of each row instead of decoding columns into Result.
+        template<typename Result, specialized_from<std::tuple> BindAttrs>
+        [[nodiscard]] auto make_view_executer(const query_relation<Result, BindAttrs>& query) -> arcxx::expected<executer<sqlite3::row_view>, arcxx::string>;
 
         template<specialized_from<std::tuple> BindAttrs>
         arcxx::expected<void, arcxx::string> exec(const query_relation<void, BindAttrs>& query);
+        // Execute a statement for each chunk of rows. Returns the number of affected rows.
+        template<specialized_from<std::tuple> BindRow>
+        arcxx::expected<std::size_t, arcxx::string> exec(const multi_row_query_relation<BindRow>& query);
         template<typename Result, specialized_from<std::tuple> BindAttrs>
         [[nodiscard]] arcxx::expected<Result, arcxx::string> exec(const query_relation<Result, BindAttrs>& query);
+        // Execute a select and return its rows in struct-of-arrays layout.
+        template<specialized_from<std::vector> Result, specialized_from<std::tuple> BindAttrs>
+        [[nodiscard]] arcxx::expected<columnar_result_t<Result>, arcxx::string> exec_columnar(const query_relation<Result, BindAttrs>& query);
+        // Insert models by a prepared statement, which is bound to each model, in transactions of options.rows_per_transaction rows.
+        // In a transaction, rows are inserted in the transaction. Returns the number of inserted rows.
+        // If it fails, rows of committed transactions remain.
+        template<is_model Mod, std::ranges::input_range Range>
+        requires std::same_as<std::remove_cvref_t<std::ranges::range_reference_t<Range>>, Mod>
+        arcxx::expected<std::size_t, arcxx::string> bulk_insert(Range&& models, const sqlite3::bulk_insert_options& options = {});
 
         template<is_model Mod>
         arcxx::expected<void, arcxx::string> create_table(decltype(abort_if_exists));
@@ -98,4 +163,5 @@ namespace arcxx {
 }
 
 #include "sqlite3/executer.ipp"
-#include "sqlite3/connector.ipp"
\ No newline at end of file
+#include "sqlite3/connector.ipp"
+#include "sqlite3/database.ipp"
\ No newline at end of file
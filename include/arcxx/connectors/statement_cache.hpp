@@ -0,0 +1,100 @@
+#pragma once
+/*
+ * ARCXX: https://github.com/akisute514/arcxx
+ * Copyright (c) 2021 akisute514
+ *
+ * Released under the MIT License.
+ */
+#include <list>
+#include <unordered_map>
+#include "../utils.hpp"
+
+namespace arcxx::detail {
+    /*
+     * LRU of prepared statements of a connection, keyed by SQL.
+     * Statement is a handle of the statement (e.g. name of server-side prepared statement) and
+     * connectors release handles returned by pop_overflow() and clear().
+     * It is not thread-safe, as well as connections.
+     */
+    template<typename Statement>
+    class statement_cache {
+        struct entry {
+            arcxx::string sql;
+            Statement statement;
+        };
+        // most recently used first
+        std::list<entry> entries;
+        // keys refer to entry::sql, which is not moved while the entry is in the list
+        std::unordered_map<arcxx::string_view, typename std::list<entry>::iterator> index;
+        std::size_t max_size;
+    public:
+        explicit statement_cache(const std::size_t capacity) noexcept : max_size(capacity) {}
+        statement_cache(const statement_cache&) = delete;
+        statement_cache(statement_cache&&) = default;
+        statement_cache& operator=(const statement_cache&) = delete;
+        statement_cache& operator=(statement_cache&&) = default;
+
+        // Returns nullptr if not cached. Found statement becomes the most recently used one.
+        [[nodiscard]] Statement* find(const arcxx::string_view sql) {
+            const auto it = index.find(sql);
+            if(it == index.end()) return nullptr;
+            entries.splice(entries.begin(), entries, it->second);
+            return &it->second->statement;
+        }
+
+        // Inserts a statement of sql which is not cached. Call pop_overflow() after inserting.
+        const entry& insert(const arcxx::string_view sql, Statement&& statement) {
+            // entries live as long as the connection, so that they are not allocated from a scoped resource
+            const pmr::global_scope scope{};
+            if constexpr(std::same_as<Statement, arcxx::string>) {
+                entries.push_front(entry{ arcxx::string{ sql }, arcxx::string{ statement } });
+            }
+            else {
+                entries.push_front(entry{ arcxx::string{ sql }, std::move(statement) });
+            }
+            index.emplace(arcxx::string_view{ entries.front().sql }, entries.begin());
+            return entries.front();
+        }
+
+        // Removes a statement of sql and returns it.
+        [[nodiscard]] std::optional<Statement> erase(const arcxx::string_view sql) {
+            const auto it = index.find(sql);
+            if(it == index.end()) return std::nullopt;
+            const auto entry_it = it->second;
+            index.erase(it);
+            auto ret = std::move(entry_it->statement);
+            entries.erase(entry_it);
+            return ret;
+        }
+
+        // Removes the least recently used statement while the cache exceeds its capacity.
+        [[nodiscard]] std::optional<Statement> pop_overflow() {
+            if(entries.size() <= max_size) return std::nullopt;
+            index.erase(arcxx::string_view{ entries.back().sql });
+            auto ret = std::move(entries.back().statement);
+            entries.pop_back();
+            return ret;
+        }
+
+        // Removes all statements and returns them.
+        [[nodiscard]] std::vector<Statement> clear() {
+            std::vector<Statement> ret;
+            ret.reserve(entries.size());
+            for(auto& e : entries) ret.push_back(std::move(e.statement));
+            index.clear();
+            entries.clear();
+            return ret;
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept {
+            return entries.size();
+        }
+        [[nodiscard]] std::size_t capacity() const noexcept {
+            return max_size;
+        }
+        // 0 disables caching. Statements exceeding the new capacity are returned by pop_overflow().
+        void set_capacity(const std::size_t n) noexcept {
+            max_size = n;
+        }
+    };
+}
@@ -46,6 +46,22 @@ namespace arcxx {
 
         [[nodiscard]] static auto insert(const Derived& model);
         [[nodiscard]] static auto insert(Derived&& model);
+        // multi-row INSERT. Models are copied.
+        template<std::ranges::input_range Range>
+        requires std::convertible_to<std::ranges::range_reference_t<Range>, const Derived&>
+        [[nodiscard]] static auto insert(Range&& models);
+
+        // INSERT ... ON CONFLICT DO UPDATE. Conflict target is primary key (or unique attribute) by default,
+        // and all other columns are updated.
+        [[nodiscard]] static auto upsert(const Derived& model);
+        template<std::ranges::input_range Range>
+        requires std::convertible_to<std::ranges::range_reference_t<Range>, const Derived&>
+        [[nodiscard]] static auto upsert(Range&& models);
+
+        // UPDATE rows of models by one statement for each chunk. Rows are identified by primary key.
+        template<std::ranges::input_range Range>
+        requires std::convertible_to<std::ranges::range_reference_t<Range>, const Derived&>
+        [[nodiscard]] static auto update_each(Range&& models);
 
         [[nodiscard]] static auto all();
 
@@ -14,7 +14,9 @@ namespace arcxx {
         insert,
         destroy,
         update,
-        condition
+        condition,
+        upsert,
+        update_each
     };
 
     enum class order {
@@ -28,6 +30,15 @@ namespace arcxx {
     template<specialized_from<std::tuple> BindAttrs>
     struct query_condition;
 
+    template<specialized_from<std::tuple> BindRow>
+    struct multi_row_query_relation;
+
+    template<specialized_from<std::tuple> BindRow>
+    struct upsert_query_relation;
+
+    template<typename Mod>
+    struct update_each_models;
+
     template<typename Result, typename... Args>
     requires ((is_attribute<Args> || std::convertible_to<Args, arcxx::string_view>) && ...)
     auto raw_query(Args&&... args);
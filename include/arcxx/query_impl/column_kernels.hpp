@@ -0,0 +1,475 @@
+#pragma once
+/*
+ * ARCXX: https://github.com/akisute514/arcxx
+ * Copyright (c) 2021 akisute514
+ *
+ * Released under the MIT License.
+ */
+#include <atomic>
+#include <bit>
+#include <limits>
+#include "../utils.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define ARCXX_HAS_X86_SIMD
+#define ARCXX_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+/*
+ * Aggregate kernels over contiguous values of columnar_result.
+ * SSE4.2 and AVX2 kernels are compiled for x86 by target attributes and chosen at runtime by CPU features,
+ * so that the library does not require -mavx2.
+ */
+namespace arcxx::column_kernels {
+    enum class instruction_set { scalar, sse4_2, avx2 };
+
+    // the best instruction set supported by the CPU
+    [[nodiscard]] inline instruction_set detected() noexcept {
+        #ifdef ARCXX_HAS_X86_SIMD
+        static const instruction_set isa = []{
+            __builtin_cpu_init();
+            if(__builtin_cpu_supports("avx2")) return instruction_set::avx2;
+            if(__builtin_cpu_supports("sse4.2")) return instruction_set::sse4_2;
+            return instruction_set::scalar;
+        }();
+        return isa;
+        #else
+        return instruction_set::scalar;
+        #endif
+    }
+
+    namespace detail {
+        inline std::atomic<instruction_set>& selected() noexcept {
+            static std::atomic<instruction_set> isa{ detected() };
+            return isa;
+        }
+    }
+    // instruction set used by kernels, which is detected() by default
+    [[nodiscard]] inline instruction_set current() noexcept {
+        return detail::selected().load(std::memory_order_relaxed);
+    }
+    // Use a lower instruction set, e.g. to compare kernels. Unsupported ones are lowered to detected().
+    inline void use(const instruction_set isa) noexcept {
+        detail::selected().store(std::min(isa, detected()), std::memory_order_relaxed);
+    }
+
+    // Values are summed in 64 bits integers or double.
+    template<typename T>
+    using sum_type = std::conditional_t<std::floating_point<T>, double, std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>>;
+
+    template<typename T>
+    concept vectorizable = std::same_as<T, std::int32_t> || std::same_as<T, std::uint32_t>
+        || std::same_as<T, std::int64_t> || std::same_as<T, std::uint64_t>
+        || std::same_as<T, float> || std::same_as<T, double>;
+
+    // Initial min_value and max_value of min_max, which are replaced by any value but NaN.
+    template<typename T>
+    [[nodiscard]] constexpr std::pair<T, T> min_max_identity() noexcept {
+        if constexpr(std::numeric_limits<T>::has_infinity) return { std::numeric_limits<T>::infinity(), -std::numeric_limits<T>::infinity() };
+        else return { std::numeric_limits<T>::max(), std::numeric_limits<T>::lowest() };
+    }
+
+    namespace detail {
+        template<typename T>
+        [[nodiscard]] inline sum_type<T> sum_scalar(const T* values, const std::size_t size) noexcept {
+            sum_type<T> result = 0;
+            for(std::size_t i = 0; i < size; ++i) result += static_cast<sum_type<T>>(values[i]);
+            return result;
+        }
+        template<typename T>
+        inline void min_max_scalar(const T* values, const std::size_t size, T& min_value, T& max_value) noexcept {
+            for(std::size_t i = 0; i < size; ++i) {
+                min_value = values[i] < min_value ? values[i] : min_value;
+                max_value = max_value < values[i] ? values[i] : max_value;
+            }
+        }
+        template<typename T>
+        inline void histogram_scalar(const T* values, const std::size_t size, const std::span<const T> bounds, std::size_t* buckets) noexcept {
+            for(std::size_t i = 0; i < size; ++i) {
+                if constexpr(std::floating_point<T>) {
+                    if(values[i] != values[i]) continue;
+                }
+                ++buckets[static_cast<std::size_t>(std::ranges::upper_bound(bounds, values[i]) - bounds.begin())];
+            }
+        }
+
+        #ifdef ARCXX_HAS_X86_SIMD
+        // integers are compared as signed, so that unsigned ones are biased by the sign bit
+        template<typename T>
+        ARCXX_TARGET("avx2") inline __m256i bias_avx2(const __m256i v) noexcept {
+            if constexpr(std::same_as<T, std::uint64_t>) return _mm256_xor_si256(v, _mm256_set1_epi64x(std::numeric_limits<std::int64_t>::min()));
+            else if constexpr(std::same_as<T, std::uint32_t>) return _mm256_xor_si256(v, _mm256_set1_epi32(std::numeric_limits<std::int32_t>::min()));
+            else return v;
+        }
+        template<typename T>
+        ARCXX_TARGET("sse4.2") inline __m128i bias_sse(const __m128i v) noexcept {
+            if constexpr(std::same_as<T, std::uint64_t>) return _mm_xor_si128(v, _mm_set1_epi64x(std::numeric_limits<std::int64_t>::min()));
+            else if constexpr(std::same_as<T, std::uint32_t>) return _mm_xor_si128(v, _mm_set1_epi32(std::numeric_limits<std::int32_t>::min()));
+            else return v;
+        }
+        // number of set bits of movemask
+        inline std::size_t count_bits(const int mask) noexcept {
+            return static_cast<std::size_t>(std::popcount(static_cast<unsigned>(mask)));
+        }
+
+        template<vectorizable T>
+        ARCXX_TARGET("avx2") inline sum_type<T> sum_avx2(const T* values, const std::size_t size) noexcept {
+            std::size_t i = 0;
+            if constexpr(std::floating_point<T>) {
+                __m256d acc0 = _mm256_setzero_pd();
+                __m256d acc1 = _mm256_setzero_pd();
+                if constexpr(std::same_as<T, double>) {
+                    for(; i + 8 <= size; i += 8) {
+                        acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(values + i));
+                        acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(values + i + 4));
+                    }
+                }
+                else {
+                    for(; i + 8 <= size; i += 8) {
+                        acc0 = _mm256_add_pd(acc0, _mm256_cvtps_pd(_mm_loadu_ps(values + i)));
+                        acc1 = _mm256_add_pd(acc1, _mm256_cvtps_pd(_mm_loadu_ps(values + i + 4)));
+                    }
+                }
+                alignas(32) double lanes[4];
+                _mm256_store_pd(lanes, _mm256_add_pd(acc0, acc1));
+                return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sum_scalar(values + i, size - i);
+            }
+            else {
+                __m256i acc0 = _mm256_setzero_si256();
+                __m256i acc1 = _mm256_setzero_si256();
+                for(; i + 8 <= size; i += 8) {
+                    if constexpr(sizeof(T) == 8) {
+                        acc0 = _mm256_add_epi64(acc0, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i)));
+                        acc1 = _mm256_add_epi64(acc1, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i + 4)));
+                    }
+                    else {
+                        const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+                        const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i + 4));
+                        if constexpr(std::is_signed_v<T>) {
+                            acc0 = _mm256_add_epi64(acc0, _mm256_cvtepi32_epi64(low));
+                            acc1 = _mm256_add_epi64(acc1, _mm256_cvtepi32_epi64(high));
+                        }
+                        else {
+                            acc0 = _mm256_add_epi64(acc0, _mm256_cvtepu32_epi64(low));
+                            acc1 = _mm256_add_epi64(acc1, _mm256_cvtepu32_epi64(high));
+                        }
+                    }
+                }
+                alignas(32) sum_type<T> lanes[4];
+                _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), _mm256_add_epi64(acc0, acc1));
+                return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sum_scalar(values + i, size - i);
+            }
+        }
+        template<vectorizable T>
+        ARCXX_TARGET("sse4.2") inline sum_type<T> sum_sse(const T* values, const std::size_t size) noexcept {
+            std::size_t i = 0;
+            if constexpr(std::floating_point<T>) {
+                __m128d acc0 = _mm_setzero_pd();
+                __m128d acc1 = _mm_setzero_pd();
+                if constexpr(std::same_as<T, double>) {
+                    for(; i + 4 <= size; i += 4) {
+                        acc0 = _mm_add_pd(acc0, _mm_loadu_pd(values + i));
+                        acc1 = _mm_add_pd(acc1, _mm_loadu_pd(values + i + 2));
+                    }
+                }
+                else {
+                    for(; i + 4 <= size; i += 4) {
+                        const __m128 v = _mm_loadu_ps(values + i);
+                        acc0 = _mm_add_pd(acc0, _mm_cvtps_pd(v));
+                        acc1 = _mm_add_pd(acc1, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+                    }
+                }
+                alignas(16) double lanes[2];
+                _mm_store_pd(lanes, _mm_add_pd(acc0, acc1));
+                return lanes[0] + lanes[1] + sum_scalar(values + i, size - i);
+            }
+            else {
+                __m128i acc0 = _mm_setzero_si128();
+                __m128i acc1 = _mm_setzero_si128();
+                for(; i + 4 <= size; i += 4) {
+                    if constexpr(sizeof(T) == 8) {
+                        acc0 = _mm_add_epi64(acc0, _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i)));
+                        acc1 = _mm_add_epi64(acc1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i + 2)));
+                    }
+                    else {
+                        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+                        if constexpr(std::is_signed_v<T>) {
+                            acc0 = _mm_add_epi64(acc0, _mm_cvtepi32_epi64(v));
+                            acc1 = _mm_add_epi64(acc1, _mm_cvtepi32_epi64(_mm_srli_si128(v, 8)));
+                        }
+                        else {
+                            acc0 = _mm_add_epi64(acc0, _mm_cvtepu32_epi64(v));
+                            acc1 = _mm_add_epi64(acc1, _mm_cvtepu32_epi64(_mm_srli_si128(v, 8)));
+                        }
+                    }
+                }
+                alignas(16) sum_type<T> lanes[2];
+                _mm_store_si128(reinterpret_cast<__m128i*>(lanes), _mm_add_epi64(acc0, acc1));
+                return lanes[0] + lanes[1] + sum_scalar(values + i, size - i);
+            }
+        }
+
+        template<vectorizable T>
+        ARCXX_TARGET("avx2") inline void min_max_avx2(const T* values, const std::size_t size, T& min_value, T& max_value) noexcept {
+            constexpr std::size_t lanes_count = 32 / sizeof(T);
+            if(size < lanes_count) return min_max_scalar(values, size, min_value, max_value);
+            alignas(32) T lanes_min[lanes_count];
+            alignas(32) T lanes_max[lanes_count];
+            std::size_t i = lanes_count;
+            if constexpr(std::same_as<T, double>) {
+                // min/max return the second operand if either is NaN, so that accumulators start from infinities
+                // and NaN of v is skipped as scalar comparisons
+                __m256d lo = _mm256_set1_pd(min_max_identity<T>().first);
+                __m256d hi = _mm256_set1_pd(min_max_identity<T>().second);
+                for(i = 0; i + lanes_count <= size; i += lanes_count) {
+                    const __m256d v = _mm256_loadu_pd(values + i);
+                    lo = _mm256_min_pd(v, lo);
+                    hi = _mm256_max_pd(v, hi);
+                }
+                _mm256_store_pd(lanes_min, lo);
+                _mm256_store_pd(lanes_max, hi);
+            }
+            else if constexpr(std::same_as<T, float>) {
+                __m256 lo = _mm256_set1_ps(min_max_identity<T>().first);
+                __m256 hi = _mm256_set1_ps(min_max_identity<T>().second);
+                for(i = 0; i + lanes_count <= size; i += lanes_count) {
+                    const __m256 v = _mm256_loadu_ps(values + i);
+                    lo = _mm256_min_ps(v, lo);
+                    hi = _mm256_max_ps(v, hi);
+                }
+                _mm256_store_ps(lanes_min, lo);
+                _mm256_store_ps(lanes_max, hi);
+            }
+            else {
+                __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values));
+                __m256i hi = lo;
+                for(; i + lanes_count <= size; i += lanes_count) {
+                    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+                    if constexpr(std::same_as<T, std::int32_t>) {
+                        lo = _mm256_min_epi32(lo, v);
+                        hi = _mm256_max_epi32(hi, v);
+                    }
+                    else if constexpr(std::same_as<T, std::uint32_t>) {
+                        lo = _mm256_min_epu32(lo, v);
+                        hi = _mm256_max_epu32(hi, v);
+                    }
+                    else {
+                        // AVX2 has no min/max of 64 bits integers
+                        const __m256i biased = bias_avx2<T>(v);
+                        lo = _mm256_blendv_epi8(lo, v, _mm256_cmpgt_epi64(bias_avx2<T>(lo), biased));
+                        hi = _mm256_blendv_epi8(hi, v, _mm256_cmpgt_epi64(biased, bias_avx2<T>(hi)));
+                    }
+                }
+                _mm256_store_si256(reinterpret_cast<__m256i*>(lanes_min), lo);
+                _mm256_store_si256(reinterpret_cast<__m256i*>(lanes_max), hi);
+            }
+            for(std::size_t lane = 0; lane < lanes_count; ++lane) {
+                min_value = lanes_min[lane] < min_value ? lanes_min[lane] : min_value;
+                max_value = max_value < lanes_max[lane] ? lanes_max[lane] : max_value;
+            }
+            min_max_scalar(values + i, size - i, min_value, max_value);
+        }
+        template<vectorizable T>
+        ARCXX_TARGET("sse4.2") inline void min_max_sse(const T* values, const std::size_t size, T& min_value, T& max_value) noexcept {
+            constexpr std::size_t lanes_count = 16 / sizeof(T);
+            if(size < lanes_count) return min_max_scalar(values, size, min_value, max_value);
+            alignas(16) T lanes_min[lanes_count];
+            alignas(16) T lanes_max[lanes_count];
+            std::size_t i = lanes_count;
+            if constexpr(std::same_as<T, double>) {
+                // NaN is skipped (see min_max_avx2)
+                __m128d lo = _mm_set1_pd(min_max_identity<T>().first);
+                __m128d hi = _mm_set1_pd(min_max_identity<T>().second);
+                for(i = 0; i + lanes_count <= size; i += lanes_count) {
+                    const __m128d v = _mm_loadu_pd(values + i);
+                    lo = _mm_min_pd(v, lo);
+                    hi = _mm_max_pd(v, hi);
+                }
+                _mm_store_pd(lanes_min, lo);
+                _mm_store_pd(lanes_max, hi);
+            }
+            else if constexpr(std::same_as<T, float>) {
+                __m128 lo = _mm_set1_ps(min_max_identity<T>().first);
+                __m128 hi = _mm_set1_ps(min_max_identity<T>().second);
+                for(i = 0; i + lanes_count <= size; i += lanes_count) {
+                    const __m128 v = _mm_loadu_ps(values + i);
+                    lo = _mm_min_ps(v, lo);
+                    hi = _mm_max_ps(v, hi);
+                }
+                _mm_store_ps(lanes_min, lo);
+                _mm_store_ps(lanes_max, hi);
+            }
+            else {
+                __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values));
+                __m128i hi = lo;
+                for(; i + lanes_count <= size; i += lanes_count) {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+                    if constexpr(std::same_as<T, std::int32_t>) {
+                        lo = _mm_min_epi32(lo, v);
+                        hi = _mm_max_epi32(hi, v);
+                    }
+                    else if constexpr(std::same_as<T, std::uint32_t>) {
+                        lo = _mm_min_epu32(lo, v);
+                        hi = _mm_max_epu32(hi, v);
+                    }
+                    else {
+                        const __m128i biased = bias_sse<T>(v);
+                        lo = _mm_blendv_epi8(lo, v, _mm_cmpgt_epi64(bias_sse<T>(lo), biased));
+                        hi = _mm_blendv_epi8(hi, v, _mm_cmpgt_epi64(biased, bias_sse<T>(hi)));
+                    }
+                }
+                _mm_store_si128(reinterpret_cast<__m128i*>(lanes_min), lo);
+                _mm_store_si128(reinterpret_cast<__m128i*>(lanes_max), hi);
+            }
+            for(std::size_t lane = 0; lane < lanes_count; ++lane) {
+                min_value = lanes_min[lane] < min_value ? lanes_min[lane] : min_value;
+                max_value = max_value < lanes_max[lane] ? lanes_max[lane] : max_value;
+            }
+            min_max_scalar(values + i, size - i, min_value, max_value);
+        }
+
+        // Add the number of values which are not less than bounds[j] to not_less[j], for values of whole vectors.
+        // Returns the number of values which are counted, and the number of them but NaN.
+        template<vectorizable T>
+        ARCXX_TARGET("avx2") inline std::pair<std::size_t, std::size_t> count_not_less_avx2(const T* values, const std::size_t size, const std::span<const T> bounds, std::size_t* not_less) noexcept {
+            constexpr std::size_t lanes_count = 32 / sizeof(T);
+            std::size_t i = 0;
+            std::size_t ordered = 0;
+            for(; i + lanes_count <= size; i += lanes_count) {
+                if constexpr(std::same_as<T, double>) {
+                    const __m256d v = _mm256_loadu_pd(values + i);
+                    ordered += count_bits(_mm256_movemask_pd(_mm256_cmp_pd(v, v, _CMP_ORD_Q)));
+                    for(std::size_t j = 0; j < bounds.size(); ++j) {
+                        not_less[j] += count_bits(_mm256_movemask_pd(_mm256_cmp_pd(v, _mm256_set1_pd(bounds[j]), _CMP_GE_OQ)));
+                    }
+                }
+                else if constexpr(std::same_as<T, float>) {
+                    const __m256 v = _mm256_loadu_ps(values + i);
+                    ordered += count_bits(_mm256_movemask_ps(_mm256_cmp_ps(v, v, _CMP_ORD_Q)));
+                    for(std::size_t j = 0; j < bounds.size(); ++j) {
+                        not_less[j] += count_bits(_mm256_movemask_ps(_mm256_cmp_ps(v, _mm256_set1_ps(bounds[j]), _CMP_GE_OQ)));
+                    }
+                }
+                else {
+                    // value >= bound is !(bound > value)
+                    const __m256i v = bias_avx2<T>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i)));
+                    ordered += lanes_count;
+                    for(std::size_t j = 0; j < bounds.size(); ++j) {
+                        if constexpr(sizeof(T) == 8) {
+                            const __m256i bound = bias_avx2<T>(_mm256_set1_epi64x(static_cast<long long>(bounds[j])));
+                            not_less[j] += lanes_count - count_bits(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(bound, v))));
+                        }
+                        else {
+                            const __m256i bound = bias_avx2<T>(_mm256_set1_epi32(static_cast<int>(bounds[j])));
+                            not_less[j] += lanes_count - count_bits(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(bound, v))));
+                        }
+                    }
+                }
+            }
+            return { i, ordered };
+        }
+        template<vectorizable T>
+        ARCXX_TARGET("sse4.2") inline std::pair<std::size_t, std::size_t> count_not_less_sse(const T* values, const std::size_t size, const std::span<const T> bounds, std::size_t* not_less) noexcept {
+            constexpr std::size_t lanes_count = 16 / sizeof(T);
+            std::size_t i = 0;
+            std::size_t ordered = 0;
+            for(; i + lanes_count <= size; i += lanes_count) {
+                if constexpr(std::same_as<T, double>) {
+                    const __m128d v = _mm_loadu_pd(values + i);
+                    ordered += count_bits(_mm_movemask_pd(_mm_cmpord_pd(v, v)));
+                    for(std::size_t j = 0; j < bounds.size(); ++j) {
+                        not_less[j] += count_bits(_mm_movemask_pd(_mm_cmpge_pd(v, _mm_set1_pd(bounds[j]))));
+                    }
+                }
+                else if constexpr(std::same_as<T, float>) {
+                    const __m128 v = _mm_loadu_ps(values + i);
+                    ordered += count_bits(_mm_movemask_ps(_mm_cmpord_ps(v, v)));
+                    for(std::size_t j = 0; j < bounds.size(); ++j) {
+                        not_less[j] += count_bits(_mm_movemask_ps(_mm_cmpge_ps(v, _mm_set1_ps(bounds[j]))));
+                    }
+                }
+                else {
+                    const __m128i v = bias_sse<T>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i)));
+                    ordered += lanes_count;
+                    for(std::size_t j = 0; j < bounds.size(); ++j) {
+                        if constexpr(sizeof(T) == 8) {
+                            const __m128i bound = bias_sse<T>(_mm_set1_epi64x(static_cast<long long>(bounds[j])));
+                            not_less[j] += lanes_count - count_bits(_mm_movemask_pd(_mm_castsi128_pd(_mm_cmpgt_epi64(bound, v))));
+                        }
+                        else {
+                            const __m128i bound = bias_sse<T>(_mm_set1_epi32(static_cast<int>(bounds[j])));
+                            not_less[j] += lanes_count - count_bits(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(bound, v))));
+                        }
+                    }
+                }
+            }
+            return { i, ordered };
+        }
+        #endif
+    }
+
+    // Sum of values. Floating point values are summed in a different order by SIMD kernels.
+    template<typename T>
+    [[nodiscard]] inline sum_type<T> sum(const T* values, const std::size_t size) noexcept {
+        #ifdef ARCXX_HAS_X86_SIMD
+        if constexpr(vectorizable<T>) {
+            switch(current()) {
+                case instruction_set::avx2:   return detail::sum_avx2(values, size);
+                case instruction_set::sse4_2: return detail::sum_sse(values, size);
+                case instruction_set::scalar: break;
+            }
+        }
+        #endif
+        return detail::sum_scalar(values, size);
+    }
+    // Update min_value and max_value by values, skipping NaN. They start from min_max_identity<T>().
+    template<typename T>
+    inline void min_max(const T* values, const std::size_t size, T& min_value, T& max_value) noexcept {
+        #ifdef ARCXX_HAS_X86_SIMD
+        if constexpr(vectorizable<T>) {
+            switch(current()) {
+                case instruction_set::avx2:   return detail::min_max_avx2(values, size, min_value, max_value);
+                case instruction_set::sse4_2: return detail::min_max_sse(values, size, min_value, max_value);
+                case instruction_set::scalar: break;
+            }
+        }
+        #endif
+        detail::min_max_scalar(values, size, min_value, max_value);
+    }
+    /*
+     * Count values into bounds.size() + 1 buckets split by bounds, which are sorted in ascending order, skipping NaN.
+     * buckets[0] is values less than bounds[0], buckets[j] is values in [bounds[j - 1], bounds[j]),
+     * and buckets[bounds.size()] is values not less than the last bound.
+     * SIMD kernels compare each value with all bounds, which is faster than binary search for tens of bounds.
+     */
+    template<typename T>
+    inline void histogram(const T* values, std::size_t size, const std::span<const T> bounds, std::size_t* buckets) noexcept {
+        std::fill_n(buckets, bounds.size() + 1, std::size_t{ 0 });
+        #ifdef ARCXX_HAS_X86_SIMD
+        if constexpr(vectorizable<T>) {
+            std::pair<std::size_t, std::size_t> counted{ 0, 0 };
+            switch(current()) {
+                case instruction_set::avx2:   counted = detail::count_not_less_avx2(values, size, bounds, buckets + 1); break;
+                case instruction_set::sse4_2: counted = detail::count_not_less_sse(values, size, bounds, buckets + 1); break;
+                case instruction_set::scalar: break;
+            }
+            // buckets[j + 1] is the number of values not less than bounds[j], and buckets are differences of them
+            auto previous = counted.second;
+            for(std::size_t j = 0; j < bounds.size(); ++j) {
+                const auto not_less = buckets[j + 1];
+                buckets[j] = previous - not_less;
+                previous = not_less;
+            }
+            buckets[bounds.size()] = previous;
+            values += counted.first;
+            size -= counted.first;
+        }
+        #endif
+        detail::histogram_scalar(values, size, bounds, buckets);
+    }
+}
+
+#ifdef ARCXX_TARGET
+#undef ARCXX_TARGET
+#endif
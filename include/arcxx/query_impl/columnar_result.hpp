@@ -0,0 +1,185 @@
+#pragma once
+/*
+ * ARCXX: https://github.com/akisute514/arcxx
+ * Copyright (c) 2021 akisute514
+ *
+ * Released under the MIT License.
+ */
+#include "../model.hpp"
+#include "column_kernels.hpp"
+
+namespace arcxx {
+    /*
+     * Values of an attribute of all rows, stored contiguously, and a packed bitmap of NULL rows.
+     * Values of NULL rows are value-initialized.
+     */
+    template<is_attribute Attr>
+    class column {
+    public:
+        using attribute_type = Attr;
+        using value_type = typename Attr::value_type;
+        // std::vector<bool> is not contiguous, so that booleans are stored as bytes
+        using storage_type = std::conditional_t<std::same_as<value_type, bool>, std::uint8_t, value_type>;
+    private:
+        std::vector<storage_type> data;
+        // bit (i % 64) of word (i / 64) is set if row i is NULL
+        std::vector<std::uint64_t> null_bits;
+        std::size_t nulls = 0;
+
+        void push_null_bit(const bool is_null) {
+            const auto bit = data.size() % 64;
+            if(bit == 0) null_bits.push_back(0);
+            if(is_null) {
+                null_bits.back() |= std::uint64_t{ 1 } << bit;
+                ++nulls;
+            }
+        }
+    public:
+        void reserve(const std::size_t rows) {
+            data.reserve(rows);
+            null_bits.reserve((rows + 63) / 64);
+        }
+        void push_back(value_type value) {
+            push_null_bit(false);
+            data.push_back(static_cast<storage_type>(std::move(value)));
+        }
+        void push_null() {
+            push_null_bit(true);
+            data.emplace_back();
+        }
+        void push_back(Attr&& attr) {
+            if(attr.has_value()) push_back(std::move(attr.value()));
+            else push_null();
+        }
+
+        // number of rows
+        std::size_t size() const noexcept { return data.size(); }
+        bool empty() const noexcept { return data.empty(); }
+        std::span<const storage_type> values() const noexcept { return data; }
+        const storage_type& operator[](const std::size_t row) const noexcept { return data[row]; }
+        bool is_null(const std::size_t row) const noexcept {
+            return (null_bits[row / 64] >> (row % 64)) & 1;
+        }
+        std::size_t null_count() const noexcept { return nulls; }
+        std::span<const std::uint64_t> null_bitmap() const noexcept { return null_bits; }
+
+        // Aggregations of non-NULL values, named after attribute_aggregator. They are computed by column_kernels.
+        std::size_t count() const noexcept { return size() - null_count(); }
+        std::optional<column_kernels::sum_type<storage_type>> sum() const noexcept
+        requires std::integral<value_type> || std::floating_point<value_type> {
+            if(count() == 0) return std::nullopt;
+            // values of NULL rows are 0
+            return column_kernels::sum(data.data(), data.size());
+        }
+        std::optional<double> avg() const noexcept
+        requires std::integral<value_type> || std::floating_point<value_type> {
+            if(count() == 0) return std::nullopt;
+            return static_cast<double>(sum().value()) / static_cast<double>(count());
+        }
+        std::optional<value_type> max() const noexcept
+        requires std::integral<value_type> || std::floating_point<value_type> {
+            return min_max().second;
+        }
+        std::optional<value_type> min() const noexcept
+        requires std::integral<value_type> || std::floating_point<value_type> {
+            return min_max().first;
+        }
+        std::pair<std::optional<value_type>, std::optional<value_type>> min_max() const noexcept
+        requires std::integral<value_type> || std::floating_point<value_type> {
+            if(count() == 0) return { std::nullopt, std::nullopt };
+            auto [min_value, max_value] = column_kernels::min_max_identity<storage_type>();
+            // runs of 64 rows blocks without NULL are given to the kernel, and the others are checked row by row
+            std::size_t word = 0;
+            while(word < null_bits.size()) {
+                std::size_t run_end = word;
+                while(run_end < null_bits.size() && null_bits[run_end] == 0) ++run_end;
+                if(run_end != word) {
+                    const auto begin = word * 64;
+                    const auto end = std::min(run_end * 64, data.size());
+                    column_kernels::min_max(data.data() + begin, end - begin, min_value, max_value);
+                    word = run_end;
+                    continue;
+                }
+                const auto end = std::min((word + 1) * 64, data.size());
+                for(auto row = word * 64; row < end; ++row) {
+                    if(is_null(row)) continue;
+                    min_value = data[row] < min_value ? data[row] : min_value;
+                    max_value = max_value < data[row] ? data[row] : max_value;
+                }
+                ++word;
+            }
+            if constexpr(std::floating_point<storage_type>) {
+                // NaN is skipped, so that min and max are NaN only if all values are NaN
+                if(max_value < min_value) return { std::numeric_limits<value_type>::quiet_NaN(), std::numeric_limits<value_type>::quiet_NaN() };
+            }
+            return { static_cast<value_type>(min_value), static_cast<value_type>(max_value) };
+        }
+        // Numbers of non-NULL values in bounds.size() + 1 buckets split by bounds. See column_kernels::histogram.
+        std::vector<std::size_t> histogram(const std::span<const value_type> bounds) const
+        requires (std::integral<value_type> || std::floating_point<value_type>) && (!std::same_as<value_type, bool>) {
+            std::vector<std::size_t> buckets(bounds.size() + 1, 0);
+            column_kernels::histogram(data.data(), data.size(), bounds, buckets.data());
+            // values of NULL rows are 0
+            if(nulls != 0) buckets[static_cast<std::size_t>(std::ranges::upper_bound(bounds, value_type{}) - bounds.begin())] -= nulls;
+            return buckets;
+        }
+    };
+
+    /*
+     * Result of a select in struct-of-arrays layout, which has a column of each selected attribute.
+     * Columns are in the order of the selected columns.
+     */
+    template<is_attribute... Attrs>
+    class columnar_result {
+    private:
+        std::tuple<column<Attrs>...> columns;
+    public:
+        using columns_type = std::tuple<column<Attrs>...>;
+        static constexpr std::size_t column_count = sizeof...(Attrs);
+
+        void reserve(const std::size_t rows) {
+            std::apply([rows](auto&... col){ (col.reserve(rows), ...); }, columns);
+        }
+
+        // number of rows
+        std::size_t size() const noexcept {
+            return std::get<0>(columns).size();
+        }
+        bool empty() const noexcept {
+            return size() == 0;
+        }
+
+        template<std::size_t N>
+        const auto& get() const noexcept { return std::get<N>(columns); }
+        template<std::size_t N>
+        auto& get() noexcept { return std::get<N>(columns); }
+        template<is_attribute Attr>
+        requires (std::same_as<Attr, Attrs> || ...)
+        const column<Attr>& get() const noexcept { return std::get<column<Attr>>(columns); }
+    };
+
+    namespace detail {
+        template<typename T>
+        struct columnar_result_of;
+        template<is_attribute... Attrs>
+        struct columnar_result_of<std::tuple<Attrs...>> {
+            using type = columnar_result<Attrs...>;
+        };
+        template<is_attribute Attr>
+        struct columnar_result_of<Attr> {
+            using type = columnar_result<Attr>;
+        };
+        // attributes of a model
+        template<is_attribute... Attrs>
+        struct columnar_result_of<std::tuple<Attrs&...>> {
+            using type = columnar_result<Attrs...>;
+        };
+        template<is_model Mod>
+        struct columnar_result_of<Mod> {
+            using type = typename columnar_result_of<decltype(std::declval<Mod&>().attributes_as_tuple())>::type;
+        };
+    }
+    // columnar_result of rows of a query, whose result is std::vector of models, tuples of attributes or attributes
+    template<typename Result>
+    using columnar_result_t = typename detail::columnar_result_of<typename Result::value_type>::type;
+}
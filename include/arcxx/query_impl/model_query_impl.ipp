@@ -13,15 +13,15 @@ namespace arcxx {
         query_relation<void, bindattr_t> ret{ query_operation::insert };
         // get attribute copy from model
         ret.bind_attrs = model.attributes_as_tuple();
-        ret.tables.push_back(detail::insert_column_names_to_string<Derived>());
+        ret.tokens.reserve(3 + std::tuple_size_v<decltype(model.attributes_as_tuple())> * 2);
+        ret.tokens.template push_fragment<&detail::insert_column_names_to_string<Derived>>(query_clause::tables);
         // insert values
-        ret.op_args.reserve(2 + std::tuple_size_v<decltype(model.attributes_as_tuple())> * 2);
-        ret.op_args.push_back("(");
+        ret.tokens.push_static(query_clause::op_args, "(");
         for(std::size_t i = 0; i < std::tuple_size_v<decltype(model.attributes_as_tuple())>; ++i){
-            if (i != 0) ret.op_args.push_back(",");
-            ret.op_args.push_back(i);
+            if (i != 0) ret.tokens.push_static(query_clause::op_args, ",");
+            ret.tokens.push_bind(query_clause::op_args, i);
         }
-        ret.op_args.push_back(")");
+        ret.tokens.push_static(query_clause::op_args, ")");
         return ret;
     }
 
@@ -32,23 +32,92 @@ namespace arcxx {
         query_relation<void, bindattr_t> ret{ query_operation::insert };
         // get attribute from model
         ret.bind_attrs = std::move(model.attributes_as_tuple());
-        ret.tables.push_back(detail::insert_column_names_to_string<Derived>());
+        ret.tokens.reserve(3 + std::tuple_size_v<decltype(model.attributes_as_tuple())> * 2);
+        ret.tokens.template push_fragment<&detail::insert_column_names_to_string<Derived>>(query_clause::tables);
         // insert values
-        ret.op_args.reserve(2 + std::tuple_size_v<decltype(model.attributes_as_tuple())> * 2);
-        ret.op_args.push_back("(");
+        ret.tokens.push_static(query_clause::op_args, "(");
         for(std::size_t i = 0; i < std::tuple_size_v<decltype(model.attributes_as_tuple())>; ++i){
-            if (i != 0) ret.op_args.push_back(",");
-            ret.op_args.push_back(i);
+            if (i != 0) ret.tokens.push_static(query_clause::op_args, ",");
+            ret.tokens.push_bind(query_clause::op_args, i);
+        }
+        ret.tokens.push_static(query_clause::op_args, ")");
+        return ret;
+    }
+
+    namespace detail {
+        template<is_model Mod, typename Relation, std::ranges::input_range Range>
+        void set_multi_row_insert(Relation& ret, Range&& models) {
+            if constexpr(std::ranges::sized_range<Range>) {
+                ret.rows.reserve(static_cast<std::size_t>(std::ranges::size(models)));
+            }
+            for(const Mod& model : models) {
+                ret.rows.emplace_back(model.attributes_as_tuple());
+            }
+            ret.tokens.reserve(3 + Relation::row_bind_count() * 2);
+            ret.tokens.template push_fragment<&insert_column_names_to_string<Mod>>(query_clause::tables);
+            // values of a row
+            ret.tokens.push_static(query_clause::op_args, "(");
+            for(std::size_t i = 0; i < Relation::row_bind_count(); ++i){
+                if (i != 0) ret.tokens.push_static(query_clause::op_args, ",");
+                ret.tokens.push_bind(query_clause::op_args, i);
+            }
+            ret.tokens.push_static(query_clause::op_args, ")");
+        }
+    }
+
+    template<typename Derived>
+    template<std::ranges::input_range Range>
+    requires std::convertible_to<std::ranges::range_reference_t<Range>, const Derived&>
+    inline auto model<Derived>::insert(Range&& models) {
+        using namespace tuptup::type_placeholders;
+        using bindattr_t = tuptup::apply_type_t<std::remove_cvref<_1>, decltype(Derived{}.attributes_as_tuple())>;
+        multi_row_query_relation<bindattr_t> ret{ query_operation::insert };
+        detail::set_multi_row_insert<Derived>(ret, std::forward<Range>(models));
+        return ret;
+    }
+
+    template<typename Derived>
+    inline auto model<Derived>::upsert(const Derived& model) {
+        return upsert(std::span<const Derived, 1>{ &model, 1 });
+    }
+
+    template<typename Derived>
+    template<std::ranges::input_range Range>
+    requires std::convertible_to<std::ranges::range_reference_t<Range>, const Derived&>
+    inline auto model<Derived>::upsert(Range&& models) {
+        using namespace tuptup::type_placeholders;
+        using bindattr_t = tuptup::apply_type_t<std::remove_cvref<_1>, decltype(Derived{}.attributes_as_tuple())>;
+        using conflict_target_t = typename detail::default_conflict_target<bindattr_t>::type;
+        using update_attrs_t = decltype(detail::attributes_except(static_cast<bindattr_t*>(nullptr), static_cast<conflict_target_t*>(nullptr)));
+        static_assert(std::tuple_size_v<conflict_target_t> > 0, "upsert requires a primary key or unique attribute");
+
+        upsert_query_relation<bindattr_t> ret{ query_operation::upsert };
+        detail::set_multi_row_insert<Derived>(ret, std::forward<Range>(models));
+        return [&ret]<typename... Targets, typename... Updates>(std::tuple<Targets...>*, std::tuple<Updates...>*){
+            return std::move(ret).template on_conflict<Targets...>().template update<Updates...>();
+        }(static_cast<conflict_target_t*>(nullptr), static_cast<update_attrs_t*>(nullptr));
+    }
+
+    template<typename Derived>
+    template<std::ranges::input_range Range>
+    requires std::convertible_to<std::ranges::range_reference_t<Range>, const Derived&>
+    inline auto model<Derived>::update_each(Range&& models) {
+        update_each_models<Derived> ret;
+        if constexpr(std::ranges::sized_range<Range>) {
+            ret.models.reserve(static_cast<std::size_t>(std::ranges::size(models)));
+        }
+        for(const Derived& model : models) {
+            ret.models.push_back(model);
         }
-        ret.op_args.push_back(")");
         return ret;
     }
 
     template<typename Derived>
     inline auto model<Derived>::all() {
-        query_relation<std::vector<Derived>, std::tuple<>> ret{ query_operation::select };
-        ret.op_args.push_back(detail::model_column_full_names_to_string<Derived>());
-        ret.tables.push_back(concat_strings("\"", Derived::table_name, "\""));
+        query_relation<arcxx::vector<Derived>, std::tuple<>> ret{ query_operation::select };
+        ret.tokens.template push_fragment<&detail::model_column_full_names_to_string<Derived>>(query_clause::op_args);
+        ret.tokens.template push_fragment<&detail::table_name_to_string<Derived>>(query_clause::tables);
+        ret.static_sql = detail::static_select_sql<&detail::model_column_full_names_to_string<Derived>, &detail::table_name_to_string<Derived>>();
 
         return ret;
     }
@@ -56,9 +125,10 @@ namespace arcxx {
     template<typename Derived>
     template<is_attribute... Attrs>
     inline auto model<Derived>::select() {
-        query_relation<std::vector<std::tuple<Attrs...>>, std::tuple<>> ret{ query_operation::select };
-        ret.op_args.push_back(detail::column_full_names_to_string<Attrs...>());
-        ret.tables.push_back(concat_strings("\"", Derived::table_name, "\""));
+        query_relation<arcxx::vector<std::tuple<Attrs...>>, std::tuple<>> ret{ query_operation::select };
+        ret.tokens.template push_fragment<&detail::column_full_names_to_string<Attrs...>>(query_clause::op_args);
+        ret.tokens.template push_fragment<&detail::table_name_to_string<Derived>>(query_clause::tables);
+        ret.static_sql = detail::static_select_sql<&detail::column_full_names_to_string<Attrs...>, &detail::table_name_to_string<Derived>>();
         return ret;
     }
 
@@ -66,24 +136,27 @@ namespace arcxx {
     template<is_attribute_aggregator... Aggregators>
     inline auto model<Derived>::select() {
         query_relation<std::tuple<typename Aggregators::attribute_type...>, std::tuple<>> ret{ query_operation::select };
-        ret.op_args.push_back(detail::column_full_names_to_string<Aggregators...>());
-        ret.tables.push_back(concat_strings("\"", Derived::table_name, "\""));
+        ret.tokens.template push_fragment<&detail::column_full_names_to_string<Aggregators...>>(query_clause::op_args);
+        ret.tokens.template push_fragment<&detail::table_name_to_string<Derived>>(query_clause::tables);
+        ret.static_sql = detail::static_select_sql<&detail::column_full_names_to_string<Aggregators...>, &detail::table_name_to_string<Derived>>();
         return ret;
     }
     template<typename Derived>
     template<is_attribute Attr>
     inline auto model<Derived>::pluck() {
-        query_relation<std::vector<Attr>, std::tuple<>> ret{ query_operation::select };
-        ret.op_args.push_back(detail::column_full_names_to_string<Attr>());
-        ret.tables.push_back(concat_strings("\"", Derived::table_name, "\""));
+        query_relation<arcxx::vector<Attr>, std::tuple<>> ret{ query_operation::select };
+        ret.tokens.template push_fragment<&detail::column_full_names_to_string<Attr>>(query_clause::op_args);
+        ret.tokens.template push_fragment<&detail::table_name_to_string<Derived>>(query_clause::tables);
+        ret.static_sql = detail::static_select_sql<&detail::column_full_names_to_string<Attr>, &detail::table_name_to_string<Derived>>();
         return ret;
     }
     template<typename Derived>
     template<is_attribute_aggregator Aggregator>
     inline auto model<Derived>::pluck(){
         query_relation<typename Aggregator::attribute_type, std::tuple<>> ret{ query_operation::select };
-        ret.op_args.push_back(detail::column_full_names_to_string<Aggregator>());
-        ret.tables.push_back(concat_strings("\"", Derived::table_name, "\""));
+        ret.tokens.template push_fragment<&detail::column_full_names_to_string<Aggregator>>(query_clause::op_args);
+        ret.tokens.template push_fragment<&detail::table_name_to_string<Derived>>(query_clause::tables);
+        ret.static_sql = detail::static_select_sql<&detail::column_full_names_to_string<Aggregator>, &detail::table_name_to_string<Derived>>();
         return ret;
     }
     template<typename Derived>
@@ -96,8 +169,8 @@ namespace arcxx {
     template<specialized_from<std::tuple> SrcBindAttrs>
     inline auto model<Derived>::destroy(query_condition<SrcBindAttrs>&& cond) {
         query_relation<void, SrcBindAttrs> ret{ query_operation::destroy };
-        ret.tables.push_back(concat_strings("\"", Derived::table_name, "\""));
-        ret.conditions = std::move(cond.condition);
+        ret.tokens = std::move(cond.condition);
+        ret.tokens.template push_fragment<&detail::table_name_to_string<Derived>>(query_clause::tables);
         ret.bind_attrs = std::move(cond.bind_attrs);
         return ret;
     }
@@ -111,10 +184,10 @@ namespace arcxx {
     template<typename Derived>
     template<specialized_from<std::tuple> SrcBindAttrs>
     inline auto model<Derived>::where(query_condition<SrcBindAttrs>&& cond) {
-        query_relation<std::vector<Derived>, SrcBindAttrs> ret{ query_operation::condition };
-        ret.op_args.push_back(detail::model_column_full_names_to_string<Derived>());
-        ret.tables.push_back(concat_strings("\"", Derived::table_name, "\""));
-        ret.conditions = std::move(cond.condition);
+        query_relation<arcxx::vector<Derived>, SrcBindAttrs> ret{ query_operation::condition };
+        ret.tokens = std::move(cond.condition);
+        ret.tokens.template push_fragment<&detail::model_column_full_names_to_string<Derived>>(query_clause::op_args);
+        ret.tokens.template push_fragment<&detail::table_name_to_string<Derived>>(query_clause::tables);
         ret.bind_attrs = std::move(cond.bind_attrs);
 
         return ret;
@@ -122,10 +195,11 @@ namespace arcxx {
 
     template<typename Derived>
     inline auto model<Derived>::limit(const std::size_t lim) {
-        query_relation<std::vector<Derived>, std::tuple<>> ret{ query_operation::select };
-        ret.op_args.push_back(detail::model_column_full_names_to_string<Derived>());
-        ret.tables.push_back(concat_strings("\"", Derived::table_name, "\""));
-        ret.options.push_back(concat_strings("LIMIT ", std::to_string(lim)));
+        query_relation<arcxx::vector<Derived>, std::tuple<>> ret{ query_operation::select };
+        ret.tokens.template push_fragment<&detail::model_column_full_names_to_string<Derived>>(query_clause::op_args);
+        ret.tokens.template push_fragment<&detail::table_name_to_string<Derived>>(query_clause::tables);
+        ret.tokens.push_static(query_clause::options, "LIMIT ");
+        ret.tokens.push_number(query_clause::options, lim);
 
         return ret;
     }
@@ -133,14 +207,18 @@ namespace arcxx {
     template<typename Derived>
     template<is_attribute Attr>
     inline auto model<Derived>::order_by(const arcxx::order order) {
-        query_relation<std::vector<Derived>, std::tuple<>> ret{ query_operation::select };
-        ret.op_args.push_back(detail::model_column_full_names_to_string<Derived>());
-        ret.tables.push_back(concat_strings("\"", Derived::table_name, "\""));
+        query_relation<arcxx::vector<Derived>, std::tuple<>> ret{ query_operation::select };
+        ret.tokens.template push_fragment<&detail::model_column_full_names_to_string<Derived>>(query_clause::op_args);
+        ret.tokens.template push_fragment<&detail::table_name_to_string<Derived>>(query_clause::tables);
 
-        ret.options.push_back(concat_strings(
-            "ORDER BY ", detail::column_full_names_to_string<Attr>(),
-            (order == arcxx::order::asc ? " ASC" : " DESC" )
-        ));
+        if(order == arcxx::order::asc) {
+            ret.tokens.template push_fragment<&detail::order_by_to_string<Attr, arcxx::order::asc>>(query_clause::options);
+            ret.static_sql = detail::static_select_sql<&detail::model_column_full_names_to_string<Derived>, &detail::table_name_to_string<Derived>, &detail::order_by_to_string<Attr, arcxx::order::asc>>();
+        }
+        else {
+            ret.tokens.template push_fragment<&detail::order_by_to_string<Attr, arcxx::order::desc>>(query_clause::options);
+            ret.static_sql = detail::static_select_sql<&detail::model_column_full_names_to_string<Derived>, &detail::table_name_to_string<Derived>, &detail::order_by_to_string<Attr, arcxx::order::desc>>();
+        }
 
         return ret;
     }
@@ -175,19 +253,15 @@ namespace arcxx {
     template<typename Referis_model>
     requires std::derived_from<Referis_model, model<Referis_model>>
     inline auto model<Derived>::join() {
-        query_relation<std::vector<Derived>, std::tuple<>> ret{ query_operation::select };
+        query_relation<arcxx::vector<Derived>, std::tuple<>> ret{ query_operation::select };
 
         using ReferenceAttribute = std::invoke_result_t<detail::get_reference_attr<Referis_model>, decltype(Derived{}.attributes_as_tuple())>;
 
         static_assert(!std::is_same_v<ReferenceAttribute, std::false_type>, "Derived model does not have reference to given model");
 
-        ret.op_args.push_back(detail::model_column_full_names_to_string<Derived>());
-        ret.tables.push_back(concat_strings(
-            "\"", Derived::table_name, "\" INNER JOIN \"",
-            ReferenceAttribute::foreign_key_type::model_type::table_name,
-            "\" ON ", detail::column_full_names_to_string<typename ReferenceAttribute::foreign_key_type>(),
-            " = ", detail::column_full_names_to_string<ReferenceAttribute>()
-        ));
+        ret.tokens.template push_fragment<&detail::model_column_full_names_to_string<Derived>>(query_clause::op_args);
+        ret.tokens.template push_fragment<&detail::join_tables_to_string<Derived, ReferenceAttribute, "INNER JOIN">>(query_clause::tables);
+        ret.static_sql = detail::static_select_sql<&detail::model_column_full_names_to_string<Derived>, &detail::join_tables_to_string<Derived, ReferenceAttribute, "INNER JOIN">>();
 
         return ret;
     }
@@ -196,19 +270,15 @@ namespace arcxx {
     template<typename Referis_model>
     requires std::derived_from<Referis_model, model<Referis_model>>
     inline auto model<Derived>::left_join() {
-        query_relation<std::vector<Derived>, std::tuple<>> ret{ query_operation::select };
+        query_relation<arcxx::vector<Derived>, std::tuple<>> ret{ query_operation::select };
 
         using ReferenceAttribute = std::invoke_result_t<detail::get_reference_attr<Referis_model>, decltype(Derived{}.attributes_as_tuple())>;
 
         static_assert(!std::is_same_v<ReferenceAttribute, std::false_type>, "Derived model does not have reference to given model");
 
-        ret.op_args.push_back(detail::model_column_full_names_to_string<Derived>());
-        ret.tables.push_back(concat_strings(
-            "\"", Derived::table_name, "\" LEFT OUTER JOIN \"",
-            ReferenceAttribute::foreign_key_type::model_type::table_name,
-            "\" ON ", detail::column_full_names_to_string<typename ReferenceAttribute::foreign_key_type>(),
-            " = ", detail::column_full_names_to_string<ReferenceAttribute>()
-        ));
+        ret.tokens.template push_fragment<&detail::model_column_full_names_to_string<Derived>>(query_clause::op_args);
+        ret.tokens.template push_fragment<&detail::join_tables_to_string<Derived, ReferenceAttribute, "LEFT OUTER JOIN">>(query_clause::tables);
+        ret.static_sql = detail::static_select_sql<&detail::model_column_full_names_to_string<Derived>, &detail::join_tables_to_string<Derived, ReferenceAttribute, "LEFT OUTER JOIN">>();
 
         return ret;
     }
@@ -216,10 +286,11 @@ namespace arcxx {
     template<typename Derived>
     template<is_attribute Attr>
     inline auto model<Derived>::group_by() {
-        query_relation<std::unordered_map<Attr, std::tuple<>>, std::tuple<>> ret{ query_operation::select };
-        ret.op_args.push_back(detail::column_full_names_to_string<Attr>());
-        ret.tables.push_back(concat_strings("\"", Derived::table_name, "\""));
-        ret.options.push_back(concat_strings("GROUP BY", detail::column_full_names_to_string<Attr>()));
+        query_relation<arcxx::unordered_map<Attr, std::tuple<>>, std::tuple<>> ret{ query_operation::select };
+        ret.tokens.template push_fragment<&detail::column_full_names_to_string<Attr>>(query_clause::op_args);
+        ret.tokens.template push_fragment<&detail::table_name_to_string<Derived>>(query_clause::tables);
+        ret.tokens.template push_fragment<&detail::group_by_to_string<Attr>>(query_clause::options);
+        ret.static_sql = detail::static_select_sql<&detail::column_full_names_to_string<Attr>, &detail::table_name_to_string<Derived>, &detail::group_by_to_string<Attr>>();
 
         return ret;
     }
@@ -228,8 +299,9 @@ namespace arcxx {
     template<typename Derived>
     inline auto model<Derived>::count() {
         query_relation<std::size_t, std::tuple<>> ret{ query_operation::select };
-        ret.op_args.push_back("count(*)");
-        ret.tables.push_back(concat_strings("\"", Derived::table_name, "\""));
+        ret.tokens.template push_fragment<&detail::count_all_to_string>(query_clause::op_args);
+        ret.tokens.template push_fragment<&detail::table_name_to_string<Derived>>(query_clause::tables);
+        ret.static_sql = detail::static_select_sql<&detail::count_all_to_string, &detail::table_name_to_string<Derived>>();
 
         return ret;
     }
@@ -239,8 +311,9 @@ namespace arcxx {
     requires requires{ typename Attr::sum; }
     inline auto model<Derived>::sum(){
         query_relation<typename Attr::sum::attribute_type, std::tuple<>> ret{ query_operation::select };
-        ret.op_args.push_back(Attr::sum::column_full_name());
-        ret.tables.push_back(concat_strings("\"", Derived::table_name, "\""));
+        ret.tokens.template push_fragment<&Attr::sum::column_full_name>(query_clause::op_args);
+        ret.tokens.template push_fragment<&detail::table_name_to_string<Derived>>(query_clause::tables);
+        ret.static_sql = detail::static_select_sql<&Attr::sum::column_full_name, &detail::table_name_to_string<Derived>>();
 
         return ret;
     }
@@ -250,8 +323,9 @@ namespace arcxx {
     requires requires{ typename Attr::avg; }
     inline auto model<Derived>::avg(){
         query_relation<typename Attr::avg::attribute_type, std::tuple<>> ret{ query_operation::select };
-        ret.op_args.push_back(Attr::avg::column_full_name());
-        ret.tables.push_back(concat_strings("\"", Derived::table_name, "\""));
+        ret.tokens.template push_fragment<&Attr::avg::column_full_name>(query_clause::op_args);
+        ret.tokens.template push_fragment<&detail::table_name_to_string<Derived>>(query_clause::tables);
+        ret.static_sql = detail::static_select_sql<&Attr::avg::column_full_name, &detail::table_name_to_string<Derived>>();
 
         return ret;
     }
@@ -261,8 +335,9 @@ namespace arcxx {
     requires requires{ typename Attr::max; }
     inline auto model<Derived>::max(){
         query_relation<typename Attr::max::attribute_type, std::tuple<>> ret{ query_operation::select };
-        ret.op_args.push_back(Attr::max::column_full_name());
-        ret.tables.push_back(concat_strings("\"", Derived::table_name, "\""));
+        ret.tokens.template push_fragment<&Attr::max::column_full_name>(query_clause::op_args);
+        ret.tokens.template push_fragment<&detail::table_name_to_string<Derived>>(query_clause::tables);
+        ret.static_sql = detail::static_select_sql<&Attr::max::column_full_name, &detail::table_name_to_string<Derived>>();
 
         return ret;
     }
@@ -272,8 +347,9 @@ namespace arcxx {
     requires requires{ typename Attr::min; }
     inline auto model<Derived>::min(){
         query_relation<typename Attr::min::attribute_type, std::tuple<>> ret{ query_operation::select };
-        ret.op_args.push_back(Attr::min::column_full_name());
-        ret.tables.push_back(concat_strings("\"", Derived::table_name, "\""));
+        ret.tokens.template push_fragment<&Attr::min::column_full_name>(query_clause::op_args);
+        ret.tokens.template push_fragment<&detail::table_name_to_string<Derived>>(query_clause::tables);
+        ret.static_sql = detail::static_select_sql<&Attr::min::column_full_name, &detail::table_name_to_string<Derived>>();
 
         return ret;
     }
@@ -0,0 +1,95 @@
+#pragma once
+/*
+ * ARCXX: https://github.com/akisute514/arcxx
+ * Copyright (c) 2021 akisute514
+ *
+ * Released under the MIT License.
+ */
+#include "../model.hpp"
+#include "query_utils.hpp"
+#include "../connectors/common_connector.hpp"
+
+namespace arcxx {
+    /*
+     * Relation of a statement which repeats a group of bind variables for each row, e.g. multi-row INSERT.
+     * Tokens of op_args are the group of one row, and their bind indices are 0 ... row_bind_count() - 1 in order.
+     * Only op_args can have bind variables, so that connectors which have positional_bind_variable can use it.
+     * Connectors split rows into chunks so that a statement has at most bind_variable_limit() variables.
+     */
+    template<specialized_from<std::tuple> BindRow>
+    struct multi_row_query_relation {
+        const query_operation operation;
+        query_tokens tokens;
+
+        std::vector<BindRow> rows;
+
+        [[nodiscard]] static consteval std::size_t row_bind_count() noexcept {
+            return std::tuple_size_v<BindRow>;
+        }
+        // Rows of each statement when a statement can have bind_limit bind variables
+        [[nodiscard]] static constexpr std::size_t rows_per_statement(const std::size_t bind_limit) noexcept {
+            return std::max<std::size_t>(1, bind_limit / std::max<std::size_t>(1, row_bind_count()));
+        }
+
+        multi_row_query_relation(const query_operation op) :
+            operation(op) {
+        }
+
+        // Statement of all rows. It may exceed the limit of bind variables of the connector.
+        template<is_connector Connector = common_connector>
+        [[nodiscard]] arcxx::sql_string to_sql() const;
+        // Render the statement of rows [first, first + count) into buff.
+        // Bindable connectors render the same SQL for the same count.
+        template<is_connector Connector = common_connector, sql_output_buffer OutputBuffer>
+        void to_sql_into(OutputBuffer& buff, const std::size_t first, const std::size_t count) const;
+
+        // Returns the number of affected rows
+        template<is_connector Connector>
+        auto exec(Connector& conn) const {
+            return conn.exec(*this);
+        }
+    };
+
+    /*
+     * Multi-row INSERT which updates conflicting rows (INSERT ... ON CONFLICT ... DO UPDATE SET ...).
+     * Conflict target is in conditions clause and assignments are in options clause.
+     * Rows of a statement must not conflict with each other.
+     */
+    template<specialized_from<std::tuple> BindRow>
+    struct upsert_query_relation : public multi_row_query_relation<BindRow> {
+        using multi_row_query_relation<BindRow>::multi_row_query_relation;
+
+        // Columns of the unique constraint (or unique index) which conflicts
+        template<is_attribute... Attrs>
+        requires (sizeof...(Attrs) > 0) && (tuptup::contains_in_tuple<Attrs, BindRow>::value && ...)
+        [[nodiscard]] auto on_conflict() &&;
+        template<is_attribute... Attrs>
+        requires (sizeof...(Attrs) > 0) && (tuptup::contains_in_tuple<Attrs, BindRow>::value && ...)
+        [[nodiscard]] auto on_conflict() const&;
+
+        // Columns which are updated to inserted values. Conflicting rows are not updated if it is empty.
+        template<is_attribute... Attrs>
+        requires (tuptup::contains_in_tuple<Attrs, BindRow>::value && ...)
+        [[nodiscard]] auto update() &&;
+        template<is_attribute... Attrs>
+        requires (tuptup::contains_in_tuple<Attrs, BindRow>::value && ...)
+        [[nodiscard]] auto update() const&;
+    };
+
+    /*
+     * Models of model::update_each. set() chooses updated columns and makes the relation.
+     * Each row of the relation is primary key attributes followed by the updated attributes.
+     */
+    template<typename Mod>
+    struct update_each_models {
+        std::vector<Mod> models;
+
+        template<is_attribute... Attrs>
+        requires (sizeof...(Attrs) > 0) && (std::same_as<typename Attrs::model_type, Mod> && ...)
+        [[nodiscard]] auto set() const&;
+        template<is_attribute... Attrs>
+        requires (sizeof...(Attrs) > 0) && (std::same_as<typename Attrs::model_type, Mod> && ...)
+        [[nodiscard]] auto set() &&;
+    };
+}
+#include "multi_row_query_relation_impl.ipp"
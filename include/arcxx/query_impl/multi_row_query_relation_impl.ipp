@@ -0,0 +1,209 @@
+#pragma once
+/*
+ * ARCXX: https://github.com/akisute514/arcxx
+ * Copyright (c) 2021 akisute514
+ *
+ * Released under the MIT License.
+ */
+namespace arcxx {
+    template<specialized_from<std::tuple> BindRow>
+    template<is_connector Connector>
+    [[nodiscard]] arcxx::sql_string multi_row_query_relation<BindRow>::to_sql() const {
+        arcxx::string buff;
+        to_sql_into<Connector>(buff, 0, rows.size());
+        return arcxx::sql_string{ std::move(buff) };
+    }
+
+    template<specialized_from<std::tuple> BindRow>
+    template<is_connector Connector, sql_output_buffer OutputBuffer>
+    void multi_row_query_relation<BindRow>::to_sql_into(OutputBuffer& buff, const std::size_t first, const std::size_t count) const {
+        buff.clear();
+
+        // columns of VALUES of update_each
+        const auto value_columns = []<typename... Attrs>(std::tuple<Attrs...>*){ return detail::column_names_to_string<Attrs...>(); }(static_cast<BindRow*>(nullptr));
+        const arcxx::string_view value_columns_str{ value_columns.c_str() };
+
+        // Visit fragments of the statement in order. row(i) visits the group of i-th row of the statement.
+        const auto render = [this, count, value_columns_str](auto&& str, auto&& clause, auto&& row) {
+            const auto rows_of_statement = [count, &str, &row] {
+                for(std::size_t i = 0; i < count; ++i) {
+                    if(i != 0) str(",");
+                    row(i);
+                }
+            };
+            if (operation == query_operation::insert || operation == query_operation::upsert) {
+                str("INSERT INTO "); clause(query_clause::tables);
+                str(" VALUES "); rows_of_statement();
+                if (operation == query_operation::upsert) {
+                    str(" ON CONFLICT ("); clause(query_clause::conditions); str(")");
+                    if(tokens.empty(query_clause::options)) str(" DO NOTHING");
+                    else { str(" DO UPDATE SET "); clause(query_clause::options); }
+                }
+                str(";");
+            }
+            else if (operation == query_operation::update_each) {
+                if constexpr(requires{ requires Connector::derived_column_list; }) {
+                    str("UPDATE "); clause(query_clause::tables);
+                    str(" SET "); clause(query_clause::options);
+                    str(" FROM (VALUES "); rows_of_statement(); str(") AS v("); str(value_columns_str); str(")");
+                    str(" WHERE "); clause(query_clause::conditions); str(";");
+                }
+                else {
+                    str("WITH v("); str(value_columns_str); str(") AS (VALUES "); rows_of_statement(); str(")");
+                    str(" UPDATE "); clause(query_clause::tables);
+                    str(" SET "); clause(query_clause::options);
+                    str(" FROM v WHERE "); clause(query_clause::conditions); str(";");
+                }
+            }
+        };
+
+        // Types of bind variables of the first row of update_each. They are not inferred from VALUES in FROM.
+        const auto bind_cast = [this]([[maybe_unused]] const std::size_t i, [[maybe_unused]] const std::size_t idx) noexcept -> arcxx::string_view {
+            if constexpr(requires{ Connector::template parameter_type<std::tuple_element_t<0, BindRow>>(); }) {
+                if(operation != query_operation::update_each || i != 0) return {};
+                arcxx::string_view ret;
+                [&ret, idx]<std::size_t... I>(std::index_sequence<I...>){
+                    static_cast<void>(((idx == I ? (ret = Connector::template parameter_type<std::tuple_element_t<I, BindRow>>(), true) : false) || ...));
+                }(std::make_index_sequence<row_bind_count()>{});
+                return ret;
+            }
+            else return {};
+        };
+
+        const auto clause_length = [this](const query_clause clause) noexcept {
+            std::size_t len = 0;
+            tokens.visit(clause,
+                [&len](const arcxx::string_view str) noexcept { len += str.size(); },
+                // only op_args has bind variables
+                [](const std::size_t) noexcept {}
+            );
+            return len;
+        };
+        // bind indices of i-th row are shifted by i * row_bind_count()
+        const auto row_length = [this, &bind_cast](const std::size_t i) noexcept {
+            std::size_t len = 0;
+            tokens.visit(query_clause::op_args,
+                [&len](const arcxx::string_view str) noexcept { len += str.size(); },
+                [&len, &bind_cast, i](const std::size_t idx) noexcept {
+                    if constexpr(requires{ Connector::positional_bind_variable; }) len += Connector::positional_bind_variable.size();
+                    else len += detail::bind_variable_length<Connector>(i * row_bind_count() + idx);
+                    len += bind_cast(i, idx).size();
+                }
+            );
+            return len;
+        };
+        const auto write_row = [this, &buff, &bind_cast, first](const std::size_t i) {
+            tokens.visit(query_clause::op_args,
+                [&buff](const arcxx::string_view str) { buff.append(str.data(), str.size()); },
+                [this, &buff, &bind_cast, first, i](const std::size_t idx) {
+                    if constexpr(requires{ Connector::positional_bind_variable; }) {
+                        buff.append(Connector::positional_bind_variable.data(), Connector::positional_bind_variable.size());
+                    }
+                    else if constexpr(Connector::bindable) {
+                        detail::write_bind_variable<Connector>(buff, i * row_bind_count() + idx);
+                        const auto cast = bind_cast(i, idx);
+                        buff.append(cast.data(), cast.size());
+                    }
+                    else {
+                        // dispatch the index to the bound attribute at compile time
+                        [this, &buff, idx, &row = rows[first + i]]<std::size_t... I>(std::index_sequence<I...>){
+                            static_cast<void>(((idx == I ? (detail::write_bound_value<Connector>(buff, std::get<I>(row)), true) : false) || ...));
+                        }(std::make_index_sequence<row_bind_count()>{});
+                    }
+                }
+            );
+        };
+
+        // pre-pass computes the length so that buff is allocated at most once on bindable connectors
+        std::size_t length = 0;
+        render(
+            [&length](const arcxx::string_view str) noexcept { length += str.size(); },
+            [&length, &clause_length](const query_clause clause) noexcept { length += clause_length(clause); },
+            [&length, &row_length](const std::size_t i) noexcept { length += row_length(i); }
+        );
+        buff.reserve(length);
+        render(
+            [&buff](const arcxx::string_view str) { buff.append(str.data(), str.size()); },
+            [this, &buff](const query_clause clause) {
+                tokens.visit(clause,
+                    [&buff](const arcxx::string_view str) { buff.append(str.data(), str.size()); },
+                    // only op_args has bind variables
+                    [](const std::size_t) noexcept {}
+                );
+            },
+            write_row
+        );
+    }
+
+    template<specialized_from<std::tuple> BindRow>
+    template<is_attribute... Attrs>
+    requires (sizeof...(Attrs) > 0) && (tuptup::contains_in_tuple<Attrs, BindRow>::value && ...)
+    inline auto upsert_query_relation<BindRow>::on_conflict() && {
+        this->tokens.erase(query_clause::conditions);
+        this->tokens.template push_fragment<&detail::column_names_to_string<Attrs...>>(query_clause::conditions);
+        return std::move(*this);
+    }
+    template<specialized_from<std::tuple> BindRow>
+    template<is_attribute... Attrs>
+    requires (sizeof...(Attrs) > 0) && (tuptup::contains_in_tuple<Attrs, BindRow>::value && ...)
+    inline auto upsert_query_relation<BindRow>::on_conflict() const& {
+        return upsert_query_relation<BindRow>{ *this }.template on_conflict<Attrs...>();
+    }
+
+    template<specialized_from<std::tuple> BindRow>
+    template<is_attribute... Attrs>
+    requires (tuptup::contains_in_tuple<Attrs, BindRow>::value && ...)
+    inline auto upsert_query_relation<BindRow>::update() && {
+        this->tokens.erase(query_clause::options);
+        if constexpr(sizeof...(Attrs) > 0) {
+            this->tokens.template push_fragment<&detail::assignments_from_to_string<"excluded", Attrs...>>(query_clause::options);
+        }
+        return std::move(*this);
+    }
+    template<specialized_from<std::tuple> BindRow>
+    template<is_attribute... Attrs>
+    requires (tuptup::contains_in_tuple<Attrs, BindRow>::value && ...)
+    inline auto upsert_query_relation<BindRow>::update() const& {
+        return upsert_query_relation<BindRow>{ *this }.template update<Attrs...>();
+    }
+
+    template<typename Mod>
+    template<is_attribute... Attrs>
+    requires (sizeof...(Attrs) > 0) && (std::same_as<typename Attrs::model_type, Mod> && ...)
+    inline auto update_each_models<Mod>::set() && {
+        using namespace tuptup::type_placeholders;
+        using attributes_t = tuptup::apply_type_t<std::remove_cvref<_1>, decltype(Mod{}.attributes_as_tuple())>;
+        using primary_keys_t = decltype(detail::primary_key_attributes(static_cast<attributes_t*>(nullptr)));
+        static_assert(std::tuple_size_v<primary_keys_t> > 0, "update_each requires a primary key");
+        static_assert(!(tuptup::contains_in_tuple<Attrs, primary_keys_t>::value || ...), "primary key can not be updated by update_each");
+
+        return [this]<typename... PrimaryKeys>(std::tuple<PrimaryKeys...>*){
+            using row_t = std::tuple<PrimaryKeys..., Attrs...>;
+            multi_row_query_relation<row_t> ret{ query_operation::update_each };
+            ret.rows.reserve(models.size());
+            for(auto& model : models) {
+                auto attributes = model.attributes_as_tuple();
+                ret.rows.emplace_back(std::move(std::get<PrimaryKeys&>(attributes))..., std::move(std::get<Attrs&>(attributes))...);
+            }
+
+            ret.tokens.reserve(4 + std::tuple_size_v<row_t> * 2);
+            ret.tokens.template push_fragment<&detail::table_name_to_string<Mod>>(query_clause::tables);
+            // values of a row
+            ret.tokens.push_static(query_clause::op_args, "(");
+            for(std::size_t i = 0; i < std::tuple_size_v<row_t>; ++i){
+                if (i != 0) ret.tokens.push_static(query_clause::op_args, ",");
+                ret.tokens.push_bind(query_clause::op_args, i);
+            }
+            ret.tokens.push_static(query_clause::op_args, ")");
+            ret.tokens.template push_fragment<&detail::equals_from_to_string<"v", PrimaryKeys...>>(query_clause::conditions);
+            ret.tokens.template push_fragment<&detail::assignments_from_to_string<"v", Attrs...>>(query_clause::options);
+            return ret;
+        }(static_cast<primary_keys_t*>(nullptr));
+    }
+    template<typename Mod>
+    template<is_attribute... Attrs>
+    requires (sizeof...(Attrs) > 0) && (std::same_as<typename Attrs::model_type, Mod> && ...)
+    inline auto update_each_models<Mod>::set() const& {
+        return update_each_models<Mod>{ *this }.template set<Attrs...>();
+    }
+}
@@ -6,6 +6,7 @@
  * Released under the MIT License.
  */
 #include "../query.hpp"
+#include "query_tokens.hpp"
 
 namespace arcxx {
     template<specialized_from<std::tuple> BindAttrs>
@@ -19,8 +20,7 @@ namespace arcxx {
         template<specialized_from<std::tuple> SrcBindAttrs>
         [[nodiscard]] query_condition<tuptup::tuple_cat_t<BindAttrs, SrcBindAttrs>> concat_conditions(query_condition<SrcBindAttrs>&&, const conjunction);
     public:
-        using str_or_bind = std::variant<arcxx::string, std::size_t>;
-        std::vector<str_or_bind> condition;
+        query_tokens condition; // tokens of query_clause::conditions
         BindAttrs bind_attrs;
 
         [[nodiscard]] static consteval std::size_t bind_attrs_count() noexcept {
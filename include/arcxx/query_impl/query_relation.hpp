@@ -8,6 +8,8 @@
 #include "../model.hpp"
 #include "query_utils.hpp"
 #include "query_condition.hpp"
+#include "sql_cache.hpp"
+#include "columnar_result.hpp"
 #include "../connectors/common_connector.hpp"
 
 namespace arcxx {
@@ -15,18 +17,17 @@ namespace arcxx {
     struct query_relation_common {
     private:
         template<is_connector Connector>
-        struct sob_to_string_impl;
+        struct tokens_to_string_impl;
     public:
-        using str_or_bind = std::variant<arcxx::string, std::size_t>;
-
         const query_operation operation;
-        std::vector<str_or_bind> op_args;
-        std::vector<str_or_bind> tables;
-        std::vector<str_or_bind> conditions;
-        std::vector<str_or_bind> options; // order, limit
+        query_tokens tokens;
 
         BindAttrs bind_attrs;
 
+        // Whole statement rendered at compile time. Empty unless the relation is built by bind-free model queries.
+        // It must be cleared when tokens are modified.
+        arcxx::string_view static_sql;
+
         [[nodiscard]] static consteval std::size_t bind_attrs_count() noexcept {
             return std::tuple_size_v<BindAttrs>;
         }
@@ -35,8 +36,17 @@ namespace arcxx {
             operation(op) {
         }
 
+        // Relations which have the same fingerprint render the same SQL on bindable connectors.
+        [[nodiscard]] std::uint64_t fingerprint() const noexcept {
+            return detail::hash_combine(static_cast<std::uint64_t>(operation), tokens.fingerprint());
+        }
+
+        // SQL of bindable connectors is cached in sql_cache<Connector>.
         template<is_connector Connector = common_connector>
-        [[nodiscard]] const arcxx::string to_sql() const;
+        [[nodiscard]] arcxx::sql_string to_sql() const;
+        // Render SQL into buff. Old contents are discarded but its capacity is reused.
+        template<is_connector Connector = common_connector, sql_output_buffer OutputBuffer>
+        void to_sql_into(OutputBuffer& buff) const;
     };
 }
 #include "query_relation_common_impl.ipp"
@@ -44,16 +54,23 @@ namespace arcxx {
 namespace arcxx{
     template<specialized_from<std::tuple> BindAttrs>
     struct query_relation<void, BindAttrs> : public query_relation_common<BindAttrs> {
+        using result_type = void;
         using query_relation_common<BindAttrs>::query_relation_common;
         template<is_connector Connector>
         auto exec(Connector& conn) const {
             return conn.exec(*this);
         }
+        // Awaitable result of the query, for connectors which execute queries asynchronously
+        template<is_connector Connector>
+        [[nodiscard]] auto exec_async(Connector& conn) const {
+            return conn.exec_async(*this);
+        }
     };
 }
 /*
  * Clang and MSVC has this bug.
  * https://bugs.llvm.org/show_bug.cgi?id=48020
  */
+#include "multi_row_query_relation.hpp"
 #include "query_relation_impl.ipp"
 #include "model_query_impl.ipp"
\ No newline at end of file
@@ -14,106 +14,186 @@ namespace arcxx {
         
         query_relation<Result, bind_attrs_t> ret{ query_operation::unspecified };
         std::size_t index = 0;
-        ret.op_args.reserve(sizeof...(Args));
-        ret.op_args = {
-            [&index]<typename Arg>(const Arg& arg) -> typename std::type_identity_t<decltype(ret)>::str_or_bind {
-                if constexpr (is_attribute<Arg>) {
-                    ++index;
-                    return index;
-                }
-                else return arcxx::string{ arg };
-            }(args)...
-        };
+        ret.tokens.reserve(sizeof...(Args));
+        ([&index, &tokens = ret.tokens]<typename Arg>(const Arg& arg) {
+            if constexpr (is_attribute<Arg>) {
+                ++index;
+                tokens.push_bind(query_clause::op_args, index);
+            }
+            else tokens.push_literal(query_clause::op_args, arg);
+        }(args), ...);
         ret.bind_attrs = tuptup::tuple_filter<is_attribute_type<_1>>(std::make_tuple(std::forward<Args>(args)...));
 
         return ret;
     }
 
-    template<specialized_from<std::tuple> BindAttrs>
-    template<is_connector Connector>
-    [[nodiscard]] const arcxx::string query_relation_common<BindAttrs>::to_sql() const {
-        sob_to_string_impl<Connector> convertor{ bind_attrs };
-        if (operation == query_operation::select) {
-            return concat_strings("SELECT ", convertor.to_string(op_args),
-                " FROM ", convertor.to_string(tables),
-                conditions.empty() ? "" : concat_strings(" WHERE ", convertor.to_string(conditions)),
-                " ", convertor.to_string(options), ";"
-            );
+    namespace detail {
+        [[nodiscard]] inline constexpr std::size_t decimal_digits(std::size_t n) noexcept {
+            std::size_t digits = 1;
+            for(; n >= 10; n /= 10) ++digits;
+            return digits;
         }
-        else if (operation == query_operation::insert) {
-            return concat_strings("INSERT INTO ", convertor.to_string(tables),
-                " VALUES ", convertor.to_string(op_args), ";"
-            );
+
+        // Length of bind variable idx. Bound values of non-bindable connectors are not counted.
+        template<is_connector Connector>
+        [[nodiscard]] inline std::size_t bind_variable_length([[maybe_unused]] const std::size_t idx) noexcept {
+            if constexpr(requires{ Connector::bind_variable_prefix; }) {
+                return Connector::bind_variable_prefix.size() + decimal_digits(idx + 1);
+            }
+            else return 0;
         }
-        else if (operation == query_operation::destroy) {
-            return concat_strings("DELETE FROM ", convertor.to_string(tables),
-                conditions.empty() ? "" : concat_strings(" WHERE ", convertor.to_string(conditions)), ";"
-            );
+
+        // Write bind variable idx of bindable connectors
+        template<is_connector Connector, sql_output_buffer OutputBuffer>
+        requires Connector::bindable
+        inline void write_bind_variable(OutputBuffer& buff, const std::size_t idx) {
+            if constexpr(requires{ Connector::bind_variable_prefix; }) {
+                std::array<typename arcxx::string::value_type, std::numeric_limits<std::size_t>::digits10 + 2> char_buff;
+                const auto [end, ec] = std::to_chars(std::to_address(char_buff.begin()), std::to_address(char_buff.end()), idx + 1);
+                buff.append(Connector::bind_variable_prefix.data(), Connector::bind_variable_prefix.size());
+                buff.append(char_buff.data(), static_cast<std::size_t>(end - char_buff.data()));
+            }
+            else {
+                const auto bind_var = Connector::bind_variable_str(idx);
+                buff.append(bind_var.data(), bind_var.size());
+            }
         }
-        else if (operation == query_operation::update) {
-            return concat_strings("UPDATE ", convertor.to_string(tables),
-                " SET ", convertor.to_string(op_args),
-                conditions.empty() ? "": concat_strings(" WHERE ", convertor.to_string(conditions)), ";"
-            );
+
+        // Write value of bound attribute as SQL literal.
+        // to_string is found by ADL (attributes derive from arcxx::attribute_common), so that convertors of connectors declared later are visible.
+        template<is_connector Connector, sql_output_buffer OutputBuffer, is_attribute Attr>
+        inline void write_bound_value(OutputBuffer& buff, const Attr& attr) {
+            if constexpr(std::same_as<OutputBuffer, arcxx::string>) {
+                buff = to_string<Connector>(attr, std::move(buff));
+            }
+            else {
+                const auto str = to_string<Connector>(attr, arcxx::string{});
+                buff.append(str.data(), str.size());
+            }
         }
-        else if (operation == query_operation::condition) {
-            return concat_strings("SELECT ", convertor.to_string(op_args),
-                " FROM ", convertor.to_string(tables),
-                " WHERE ", convertor.to_string(conditions),
-                convertor.to_string(options), ";"
-            );
+    }
+
+    template<specialized_from<std::tuple> BindAttrs>
+    template<is_connector Connector>
+    [[nodiscard]] arcxx::sql_string query_relation_common<BindAttrs>::to_sql() const {
+        if constexpr(bind_attrs_count() == 0) {
+            if(!static_sql.empty()) return arcxx::sql_string{ static_sql };
+        }
+        // relations with literals (e.g. LIMIT) are not cached, or the cache would be filled with one-off statements
+        if constexpr(Connector::bindable) {
+            if(tokens.cacheable()) {
+                const auto key = fingerprint();
+                if(const auto cached = sql_cache<Connector>::find(key, operation, tokens)) {
+                    return arcxx::sql_string{ cached.value() };
+                }
+                arcxx::string buff;
+                to_sql_into<Connector>(buff);
+                if(const auto cached = sql_cache<Connector>::insert(key, operation, tokens, buff)) {
+                    return arcxx::sql_string{ cached.value() };
+                }
+                return arcxx::sql_string{ std::move(buff) };
+            }
         }
-        else {
-            return concat_strings(convertor.to_string(op_args), ";");
+        arcxx::string buff;
+        to_sql_into<Connector>(buff);
+        return arcxx::sql_string{ std::move(buff) };
+    }
+
+    template<specialized_from<std::tuple> BindAttrs>
+    template<is_connector Connector, sql_output_buffer OutputBuffer>
+    void query_relation_common<BindAttrs>::to_sql_into(OutputBuffer& buff) const {
+        buff.clear();
+        if constexpr(bind_attrs_count() == 0) {
+            if(!static_sql.empty()) {
+                buff.append(static_sql.data(), static_sql.size());
+                return;
+            }
         }
+
+        const tokens_to_string_impl<Connector> convertor{ tokens, bind_attrs };
+        // Visit fragments of the statement in order
+        const auto render = [this](auto&& str, auto&& clause) {
+            const bool has_conditions = !tokens.empty(query_clause::conditions);
+            if (operation == query_operation::select) {
+                str("SELECT "); clause(query_clause::op_args);
+                str(" FROM "); clause(query_clause::tables);
+                if(has_conditions) { str(" WHERE "); clause(query_clause::conditions); }
+                str(" "); clause(query_clause::options); str(";");
+            }
+            else if (operation == query_operation::insert) {
+                str("INSERT INTO "); clause(query_clause::tables);
+                str(" VALUES "); clause(query_clause::op_args); str(";");
+            }
+            else if (operation == query_operation::destroy) {
+                str("DELETE FROM "); clause(query_clause::tables);
+                if(has_conditions) { str(" WHERE "); clause(query_clause::conditions); }
+                str(";");
+            }
+            else if (operation == query_operation::update) {
+                str("UPDATE "); clause(query_clause::tables);
+                str(" SET "); clause(query_clause::op_args);
+                if(has_conditions) { str(" WHERE "); clause(query_clause::conditions); }
+                str(";");
+            }
+            else if (operation == query_operation::condition) {
+                str("SELECT "); clause(query_clause::op_args);
+                str(" FROM "); clause(query_clause::tables);
+                str(" WHERE "); clause(query_clause::conditions);
+                clause(query_clause::options); str(";");
+            }
+            else {
+                clause(query_clause::op_args); str(";");
+            }
+        };
+
+        // pre-pass computes the length so that buff is allocated at most once
+        std::size_t length = 0;
+        render(
+            [&length](const arcxx::string_view str) noexcept { length += str.size(); },
+            [&length, &convertor](const query_clause clause) noexcept { length += convertor.length(clause); }
+        );
+        buff.reserve(length);
+        render(
+            [&buff](const arcxx::string_view str) { buff.append(str.data(), str.size()); },
+            [&buff, &convertor](const query_clause clause) { convertor.write(buff, clause); }
+        );
     }
 
     template<specialized_from<std::tuple> BindAttrs>
     template<is_connector Connector>
-    struct query_relation_common<BindAttrs>::sob_to_string_impl {
+    struct query_relation_common<BindAttrs>::tokens_to_string_impl {
+        const query_tokens& tokens;
         const BindAttrs& bind_attrs;
-        const std::array<std::function<arcxx::string(arcxx::string&&)>, std::tuple_size_v<BindAttrs>> to_string_func;
 
-        sob_to_string_impl(const BindAttrs& attrs) :
-            bind_attrs(attrs),
-            to_string_func([&attrs]<std::size_t... I>(std::index_sequence<I...>){
-                if constexpr(Connector::bindable){
-                    return std::array<std::function<arcxx::string(arcxx::string&&)>, std::tuple_size_v<BindAttrs>>{};
-                }
-                else{
-                    const auto lambda_generator = [&attrs]<std::size_t N>(std::integral_constant<std::size_t, N>) -> std::function<arcxx::string(arcxx::string&&)>{
-                        return [&attrs](arcxx::string&& buff){
-                            return arcxx::to_string<Connector>(std::get<N>(attrs), std::move(buff));
-                        };
-                    };
-                    return std::array<std::function<arcxx::string(arcxx::string&&)>, std::tuple_size_v<BindAttrs>>{
-                        lambda_generator(std::integral_constant<std::size_t, I>{})...
-                    };
-                }
-            }(std::make_index_sequence<std::tuple_size_v<BindAttrs>>{})){
+        // Exact for bindable connectors. Bound values of non-bindable connectors are not counted.
+        std::size_t length(const query_clause clause) const noexcept {
+            std::size_t len = 0;
+            tokens.visit(clause,
+                [&len](const arcxx::string_view str) noexcept { len += str.size(); },
+                [&len](const std::size_t idx) noexcept { len += detail::bind_variable_length<Connector>(idx); }
+            );
+            return len;
         }
 
-        arcxx::string to_string(const std::vector<str_or_bind>& sobs) const {
-            arcxx::string buff;
-            buff.reserve(std::bit_ceil(sobs.size()*2));
+        template<sql_output_buffer OutputBuffer>
+        void write(OutputBuffer& buff, const query_clause clause) const {
+            tokens.visit(clause,
+                [&buff](const arcxx::string_view str) { buff.append(str.data(), str.size()); },
+                [&buff, this](const std::size_t idx) { this->write_bind(buff, idx); }
+            );
+        }
 
-            if constexpr (Connector::bindable){
-                for(const auto& sob : sobs) {
-                    visit_by_lambda(sob,
-                        [&buff](const arcxx::string& str) { buff += str; },
-                        [&buff](const std::size_t idx) { buff += Connector::bind_variable_str(idx); }
-                    );
-                }
+        template<sql_output_buffer OutputBuffer>
+        void write_bind(OutputBuffer& buff, const std::size_t idx) const {
+            if constexpr(Connector::bindable) {
+                detail::write_bind_variable<Connector>(buff, idx);
             }
-            else{
-                for(const auto& sob : sobs) {
-                    visit_by_lambda(sob,
-                        [&buff](const arcxx::string& str) { buff += str; },
-                        [&buff, this](const std::size_t idx) { buff = this->to_string_func[idx](std::move(buff)); }
-                    );
-                }
+            else {
+                // dispatch the index to the bound attribute at compile time
+                [this, &buff, idx]<std::size_t... I>(std::index_sequence<I...>){
+                    static_cast<void>(((idx == I ? (detail::write_bound_value<Connector>(buff, std::get<I>(this->bind_attrs)), true) : false) || ...));
+                }(std::make_index_sequence<std::tuple_size_v<BindAttrs>>{});
             }
-            return buff;
         }
     };
 }
\ No newline at end of file
@@ -14,6 +14,17 @@ namespace arcxx {
         [[nodiscard]] auto exec(Connector& conn) const {
             return conn.exec(*this);
         }
+        // Awaitable result of the query, for connectors which execute queries asynchronously
+        template<is_connector Connector>
+        [[nodiscard]] auto exec_async(Connector& conn) const {
+            return conn.exec_async(*this);
+        }
+        // Rows of the query in struct-of-arrays layout. See columnar_result.
+        template<is_connector Connector>
+        requires specialized_from<Result, std::vector>
+        [[nodiscard]] auto exec_columnar(Connector& conn) const {
+            return conn.exec_columnar(*this);
+        }
 
         /* scalar */
         template<is_attribute Attr>
@@ -12,24 +12,22 @@ namespace arcxx {
     template<typename Result, specialized_from<std::tuple> BindAttrs>
     template<is_attribute_aggregator... Attrs>
     inline auto query_relation<Result, BindAttrs>::select() const& requires specialized_from<Result, std::unordered_map>{
-        query_relation<std::unordered_map<typename Result::key_type, std::tuple<typename Attrs::attribute_type...>>, BindAttrs> ret{ query_operation::select };
-        ret.op_args.push_back(detail::column_full_names_to_string<typename Result::key_type, Attrs...>());
-        ret.tables = this->tables;
+        query_relation<arcxx::unordered_map<typename Result::key_type, std::tuple<typename Attrs::attribute_type...>>, BindAttrs> ret{ query_operation::select };
+        ret.tokens = this->tokens;
+        ret.tokens.erase(query_clause::op_args);
+        ret.tokens.template push_fragment<&detail::column_full_names_to_string<typename Result::key_type, Attrs...>>(query_clause::op_args);
 
-        ret.conditions = this->conditions;
-        ret.options = this->options;
         ret.bind_attrs = this->bind_attrs;
         return ret;
     }
     template<typename Result, specialized_from<std::tuple> BindAttrs>
     template<is_attribute_aggregator... Attrs>
     inline auto query_relation<Result, BindAttrs>::select() && requires specialized_from<Result, std::unordered_map>{
-        query_relation<std::unordered_map<typename Result::key_type, std::tuple<typename Attrs::attribute_type...>>, BindAttrs> ret{ query_operation::select };
-        ret.op_args.push_back(detail::column_full_names_to_string<typename Result::key_type, Attrs...>());
-        ret.tables = std::move(this->tables);
+        query_relation<arcxx::unordered_map<typename Result::key_type, std::tuple<typename Attrs::attribute_type...>>, BindAttrs> ret{ query_operation::select };
+        ret.tokens = std::move(this->tokens);
+        ret.tokens.erase(query_clause::op_args);
+        ret.tokens.template push_fragment<&detail::column_full_names_to_string<typename Result::key_type, Attrs...>>(query_clause::op_args);
 
-        ret.conditions = std::move(this->conditions);
-        ret.options = std::move(this->options);
         ret.bind_attrs = std::move(this->bind_attrs);
         return ret;
     }
@@ -37,24 +35,22 @@ namespace arcxx {
     template<typename Result, specialized_from<std::tuple> BindAttrs>
     template<is_attribute_aggregator Attr>
     inline auto query_relation<Result, BindAttrs>::pluck() const& requires specialized_from<Result, std::unordered_map>{
-        query_relation<std::unordered_map<typename Result::key_type, typename Attr::attribute_type>, BindAttrs> ret{ query_operation::select };
-        ret.op_args.push_back(detail::column_full_names_to_string<typename Result::key_type, Attr>());
-        ret.tables = this->tables;
+        query_relation<arcxx::unordered_map<typename Result::key_type, typename Attr::attribute_type>, BindAttrs> ret{ query_operation::select };
+        ret.tokens = this->tokens;
+        ret.tokens.erase(query_clause::op_args);
+        ret.tokens.template push_fragment<&detail::column_full_names_to_string<typename Result::key_type, Attr>>(query_clause::op_args);
 
-        ret.conditions = this->conditions;
-        ret.options = this->options;
         ret.bind_attrs = this->bind_attrs;
         return ret;
     }
     template<typename Result, specialized_from<std::tuple> BindAttrs>
     template<is_attribute_aggregator Attr>
     inline auto query_relation<Result, BindAttrs>::pluck() && requires specialized_from<Result, std::unordered_map>{
-        query_relation<std::unordered_map<typename Result::key_type, typename Attr::attribute_type>, BindAttrs> ret{ query_operation::select };
-        ret.op_args.push_back(detail::column_full_names_to_string<typename Result::key_type, Attr>());
-        ret.tables = std::move(this->tables);
+        query_relation<arcxx::unordered_map<typename Result::key_type, typename Attr::attribute_type>, BindAttrs> ret{ query_operation::select };
+        ret.tokens = std::move(this->tokens);
+        ret.tokens.erase(query_clause::op_args);
+        ret.tokens.template push_fragment<&detail::column_full_names_to_string<typename Result::key_type, Attr>>(query_clause::op_args);
 
-        ret.conditions = std::move(this->conditions);
-        ret.options = std::move(this->options);
         ret.bind_attrs = std::move(this->bind_attrs);
         return ret;
     }
@@ -74,21 +70,11 @@ namespace arcxx {
     template<specialized_from<std::tuple> SrcBindAttrs>
     inline auto query_relation<Result, BindAttrs>::where(query_condition<SrcBindAttrs>&& cond) && requires specialized_from<Result, std::unordered_map>{
         query_relation<Result, tuptup::tuple_cat_t<BindAttrs, SrcBindAttrs>> ret{ this->operation };
-        ret.op_args = std::move(this->op_args);
-        ret.tables = std::move(this->tables);
-
-        if(!this->conditions.empty()){
-            ret.conditions = std::move(this->conditions);
-            ret.conditions.push_back(" AND ");
-        }
-        for(auto& cond : cond.condition){
-            visit_by_lambda(std::move(cond),
-                [&ret_cond = ret.conditions](arcxx::string&& str) { ret_cond.push_back(std::move(str)); },
-                [&ret_cond = ret.conditions](const std::size_t idx) { ret_cond.push_back(idx + std::tuple_size_v<BindAttrs>); }
-            );
+        ret.tokens = std::move(this->tokens);
+        if(!ret.tokens.empty(query_clause::conditions)){
+            ret.tokens.push_static(query_clause::conditions, " AND ");
         }
-
-        ret.options = std::move(this->options);
+        ret.tokens.append(cond.condition, std::tuple_size_v<BindAttrs>);
         ret.bind_attrs = std::tuple_cat(std::move(this->bind_attrs), std::move(cond.bind_attrs));
         return ret;
     }
@@ -97,37 +83,28 @@ namespace arcxx {
     template<specialized_from<std::tuple> SrcBindAttrs>
     inline auto query_relation<Result, BindAttrs>::where(query_condition<SrcBindAttrs>&& cond) const& requires specialized_from<Result, std::unordered_map>{
         query_relation<Result, tuptup::tuple_cat_t<BindAttrs, SrcBindAttrs>> ret{ this->operation };
-        ret.op_args = this->op_args;
-        ret.tables = this->tables;
-        if(!this->conditions.empty()){
-            ret.conditions = this->conditions;
-            ret.conditions.push_back(" AND ");
+        ret.tokens = this->tokens;
+        if(!ret.tokens.empty(query_clause::conditions)){
+            ret.tokens.push_static(query_clause::conditions, " AND ");
         }
-        for(auto& cond : cond.condition){
-            visit_by_lambda(std::move(cond),
-                [&ret_cond = ret.conditions](arcxx::string&& str) { ret_cond.push_back(std::move(str)); },
-                [&ret_cond = ret.conditions](const std::size_t idx) { ret_cond.push_back(idx + std::tuple_size_v<BindAttrs>); }
-            );
-        }
-
-        ret.options = this->options;
+        ret.tokens.append(cond.condition, std::tuple_size_v<BindAttrs>);
         ret.bind_attrs = std::tuple_cat(this->bind_attrs, std::move(cond.bind_attrs));
         return ret;
     }
 
     template<typename Result, specialized_from<std::tuple> BindAttrs>
     inline auto query_relation<Result, BindAttrs>::limit(const std::size_t lim) && requires specialized_from<Result, std::unordered_map>{
-        this->options.push_back(concat_strings(" LIMIT ", std::to_string(lim)));
+        this->static_sql = {};
+        this->tokens.push_static(query_clause::options, " LIMIT ");
+        this->tokens.push_number(query_clause::options, lim);
         return *this;
     }
     template<typename Result, specialized_from<std::tuple> BindAttrs>
     inline auto query_relation<Result, BindAttrs>::limit(const std::size_t lim) const& requires specialized_from<Result, std::unordered_map>{
         query_relation<Result, BindAttrs> ret{ this->operation };
-        ret.op_args = this->op_args;
-        ret.tables = this->tables;
-        ret.conditions = this->conditions;
-        ret.options = this->options;
-        ret.options.push_back(concat_strings(" LIMIT ", std::to_string(lim)));
+        ret.tokens = this->tokens;
+        ret.tokens.push_static(query_clause::options, " LIMIT ");
+        ret.tokens.push_number(query_clause::options, lim);
         ret.bind_attrs = this->bind_attrs;
 
         return ret;
@@ -136,10 +113,11 @@ namespace arcxx {
     template<typename Result, specialized_from<std::tuple> BindAttrs>
     template<is_attribute Attr>
     inline auto query_relation<Result, BindAttrs>::order_by(const arcxx::order order) && requires specialized_from<Result, std::unordered_map>{
-        this->options.push_back(concat_strings(
-            " ORDER BY ", detail::column_full_names_to_string<Attr>(),
-            order == arcxx::order::asc ? " ASC" : " DESC"
-        ));
+        this->static_sql = {};
+        this->tokens.push_static(query_clause::options, " ORDER BY ");
+        this->tokens.template push_fragment<&detail::column_full_names_to_string<Attr>>(query_clause::options);
+        if(order == arcxx::order::asc) this->tokens.push_static(query_clause::options, " ASC");
+        else this->tokens.push_static(query_clause::options, " DESC");
 
         return *this;
     }
@@ -147,39 +125,36 @@ namespace arcxx {
     template<is_attribute Attr>
     inline auto query_relation<Result, BindAttrs>::order_by(const arcxx::order order) const& requires specialized_from<Result, std::unordered_map>{
         query_relation<Result, BindAttrs> ret{ this->operation };
-        ret.op_args = this->op_args;
-        ret.tables = this->tables;
-        ret.conditions = this->conditions;
+        ret.tokens = this->tokens;
         ret.bind_attrs = this->bind_attrs;
-        ret.options = this->options;
 
-        ret.options.push_back(concat_strings(
-            " ORDER BY ", detail::column_full_names_to_string<Attr>(),
-            order == arcxx::order::asc ? " ASC" : " DESC"
-        ));
+        ret.tokens.push_static(query_clause::options, " ORDER BY ");
+        ret.tokens.template push_fragment<&detail::column_full_names_to_string<Attr>>(query_clause::options);
+        if(order == arcxx::order::asc) ret.tokens.push_static(query_clause::options, " ASC");
+        else ret.tokens.push_static(query_clause::options, " DESC");
 
         return ret;
     }
 
     template<typename Result, specialized_from<std::tuple> BindAttrs>
     inline auto query_relation<Result, BindAttrs>::count() && requires specialized_from<Result, std::unordered_map>{
-        query_relation<std::unordered_map<typename Result::key_type, std::size_t>, BindAttrs> ret{ query_operation::select };
-        ret.op_args.push_back(detail::column_full_names_to_string<typename Result::key_type>() + ",count(*)");
-        ret.tables = std::move(this->tables);
+        query_relation<arcxx::unordered_map<typename Result::key_type, std::size_t>, BindAttrs> ret{ query_operation::select };
+        ret.tokens = std::move(this->tokens);
+        ret.tokens.erase(query_clause::op_args);
+        ret.tokens.template push_fragment<&detail::column_full_names_to_string<typename Result::key_type>>(query_clause::op_args);
+        ret.tokens.push_static(query_clause::op_args, ",count(*)");
 
-        ret.conditions = std::move(this->conditions);
-        ret.options = std::move(this->options);
         ret.bind_attrs = std::move(this->bind_attrs);
         return ret;
     }
     template<typename Result, specialized_from<std::tuple> BindAttrs>
     inline auto query_relation<Result, BindAttrs>::count() const& requires specialized_from<Result, std::unordered_map>{
-        query_relation<std::unordered_map<typename Result::key_type, std::size_t>, BindAttrs> ret{ query_operation::select };
-        ret.op_args.push_back(detail::column_full_names_to_string<typename Result::key_type>() + ",count(*)");
-        ret.tables = this->tables;
+        query_relation<arcxx::unordered_map<typename Result::key_type, std::size_t>, BindAttrs> ret{ query_operation::select };
+        ret.tokens = this->tokens;
+        ret.tokens.erase(query_clause::op_args);
+        ret.tokens.template push_fragment<&detail::column_full_names_to_string<typename Result::key_type>>(query_clause::op_args);
+        ret.tokens.push_static(query_clause::op_args, ",count(*)");
 
-        ret.conditions = this->conditions;
-        ret.options = this->options;
         ret.bind_attrs = this->bind_attrs;
         return ret;
     }
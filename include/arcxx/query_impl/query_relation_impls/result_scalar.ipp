@@ -24,22 +24,11 @@ namespace arcxx {
     template<specialized_from<std::tuple> SrcBindAttrs>
     inline auto query_relation<Result, BindAttrs>::where(query_condition<SrcBindAttrs>&& cond) &&{
         query_relation<Result, tuptup::tuple_cat_t<BindAttrs, SrcBindAttrs>> ret{ this->operation };
-
-        ret.op_args = std::move(this->op_args);
-        ret.tables = std::move(this->tables);
-
-        if(!this->conditions.empty()){
-            ret.conditions = std::move(this->conditions);
-            ret.conditions.push_back(" AND ");
-        }
-        for(auto& cond : cond.condition){
-            visit_by_lambda(std::move(cond),
-                [&ret_cond = ret.conditions](arcxx::string&& str) { ret_cond.push_back(std::move(str)); },
-                [&ret_cond = ret.conditions](const std::size_t idx) { ret_cond.push_back(idx + std::tuple_size_v<BindAttrs>); }
-            );
+        ret.tokens = std::move(this->tokens);
+        if(!ret.tokens.empty(query_clause::conditions)){
+            ret.tokens.push_static(query_clause::conditions, " AND ");
         }
-
-        ret.options = std::move(this->options);
+        ret.tokens.append(cond.condition, std::tuple_size_v<BindAttrs>);
         ret.bind_attrs = std::tuple_cat(std::move(this->bind_attrs), std::move(cond.bind_attrs));
         return ret;
     }
@@ -48,23 +37,11 @@ namespace arcxx {
     template<specialized_from<std::tuple> SrcBindAttrs>
     inline auto query_relation<Result, BindAttrs>::where(query_condition<SrcBindAttrs>&& cond) const&{
         query_relation<Result, tuptup::tuple_cat_t<BindAttrs, SrcBindAttrs>> ret{ this->operation };
-
-        ret.op_args = this->op_args;
-        ret.tables = this->tables;
-
-        if(!this->conditions.empty()){
-            ret.conditions = this->conditions;
-            ret.conditions.push_back(" AND ");
-        }
-
-        for(auto& cond : cond.condition){
-            visit_by_lambda(std::move(cond),
-                [&ret_cond = ret.conditions](arcxx::string&& str) { ret_cond.push_back(std::move(str)); },
-                [&ret_cond = ret.conditions](const std::size_t idx) { ret_cond.push_back(idx + std::tuple_size_v<BindAttrs>); }
-            );
+        ret.tokens = this->tokens;
+        if(!ret.tokens.empty(query_clause::conditions)){
+            ret.tokens.push_static(query_clause::conditions, " AND ");
         }
-
-        ret.options = this->options;
+        ret.tokens.append(cond.condition, std::tuple_size_v<BindAttrs>);
         ret.bind_attrs = std::tuple_cat(this->bind_attrs, std::move(cond.bind_attrs));
 
         return ret;
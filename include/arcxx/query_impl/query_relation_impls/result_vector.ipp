@@ -12,26 +12,24 @@ namespace arcxx {
     template<typename Result, specialized_from<std::tuple> BindAttrs>
     template<is_attribute... Attrs>
     inline auto query_relation<Result, BindAttrs>::select() const& requires specialized_from<Result, std::vector>{
-        query_relation<std::vector<std::tuple<Attrs...>>, BindAttrs> ret{ query_operation::select };
+        query_relation<arcxx::vector<std::tuple<Attrs...>>, BindAttrs> ret{ query_operation::select };
 
-        ret.op_args.push_back(detail::column_full_names_to_string<Attrs...>());
-        ret.tables = this->tables;
+        ret.tokens = this->tokens;
+        ret.tokens.erase(query_clause::op_args);
+        ret.tokens.template push_fragment<&detail::column_full_names_to_string<Attrs...>>(query_clause::op_args);
 
-        ret.conditions = this->conditions;
-        ret.options = this->options;
         ret.bind_attrs = this->bind_attrs;
         return ret;
     }
     template<typename Result, specialized_from<std::tuple> BindAttrs>
     template<is_attribute... Attrs>
     inline auto query_relation<Result, BindAttrs>::select() && requires specialized_from<Result, std::vector>{
-        query_relation<std::vector<std::tuple<Attrs...>>, BindAttrs> ret{ query_operation::select };
+        query_relation<arcxx::vector<std::tuple<Attrs...>>, BindAttrs> ret{ query_operation::select };
 
-        ret.op_args.push_back(detail::column_full_names_to_string<Attrs...>());
-        ret.tables = std::move(this->tables);
+        ret.tokens = std::move(this->tokens);
+        ret.tokens.erase(query_clause::op_args);
+        ret.tokens.template push_fragment<&detail::column_full_names_to_string<Attrs...>>(query_clause::op_args);
 
-        ret.conditions = std::move(this->conditions);
-        ret.options = std::move(this->options);
         ret.bind_attrs = std::move(this->bind_attrs);
         return ret;
     }
@@ -41,11 +39,10 @@ namespace arcxx {
     inline auto query_relation<Result, BindAttrs>::select() const& requires specialized_from<Result, std::vector>{
         query_relation<std::tuple<typename Attrs::attribute_type...>, BindAttrs> ret{ query_operation::select };
 
-        ret.op_args.push_back(detail::column_full_names_to_string<Attrs...>());
-        ret.tables = this->tables;
+        ret.tokens = this->tokens;
+        ret.tokens.erase(query_clause::op_args);
+        ret.tokens.template push_fragment<&detail::column_full_names_to_string<Attrs...>>(query_clause::op_args);
 
-        ret.conditions = this->conditions;
-        ret.options = this->options;
         ret.bind_attrs = this->bind_attrs;
         return ret;
     }
@@ -54,11 +51,10 @@ namespace arcxx {
     inline auto query_relation<Result, BindAttrs>::select() && requires specialized_from<Result, std::vector>{
         query_relation<std::tuple<typename Attrs::attribute_type...>, BindAttrs> ret{ query_operation::select };
 
-        ret.op_args.push_back(detail::column_full_names_to_string<Attrs...>());
-        ret.tables = std::move(this->tables);
+        ret.tokens = std::move(this->tokens);
+        ret.tokens.erase(query_clause::op_args);
+        ret.tokens.template push_fragment<&detail::column_full_names_to_string<Attrs...>>(query_clause::op_args);
 
-        ret.conditions = std::move(this->conditions);
-        ret.options = std::move(this->options);
         ret.bind_attrs = std::move(this->bind_attrs);
         return ret;
     }
@@ -66,26 +62,24 @@ namespace arcxx {
     template<typename Result, specialized_from<std::tuple> BindAttrs>
     template<is_attribute Attr>
     inline auto query_relation<Result, BindAttrs>::pluck() const& requires specialized_from<Result, std::vector>{
-        query_relation<std::vector<Attr>, BindAttrs> ret{ query_operation::select };
+        query_relation<arcxx::vector<Attr>, BindAttrs> ret{ query_operation::select };
 
-        ret.op_args.push_back(detail::column_full_names_to_string<Attr>());
-        ret.tables = this->tables;
+        ret.tokens = this->tokens;
+        ret.tokens.erase(query_clause::op_args);
+        ret.tokens.template push_fragment<&detail::column_full_names_to_string<Attr>>(query_clause::op_args);
 
-        ret.conditions = this->conditions;
-        ret.options = this->options;
         ret.bind_attrs = this->bind_attrs;
         return ret;
     }
     template<typename Result, specialized_from<std::tuple> BindAttrs>
     template<is_attribute Attr>
     inline auto query_relation<Result, BindAttrs>::pluck() && requires specialized_from<Result, std::vector>{
-        query_relation<std::vector<Attr>, BindAttrs> ret{ query_operation::select };
+        query_relation<arcxx::vector<Attr>, BindAttrs> ret{ query_operation::select };
 
-        ret.op_args.push_back(detail::column_full_names_to_string<Attr>());
-        ret.tables = std::move(this->tables);
+        ret.tokens = std::move(this->tokens);
+        ret.tokens.erase(query_clause::op_args);
+        ret.tokens.template push_fragment<&detail::column_full_names_to_string<Attr>>(query_clause::op_args);
 
-        ret.conditions = std::move(this->conditions);
-        ret.options = std::move(this->options);
         ret.bind_attrs = std::move(this->bind_attrs);
         return ret;
     }
@@ -94,11 +88,10 @@ namespace arcxx {
     inline auto query_relation<Result, BindAttrs>::pluck() && requires specialized_from<Result, std::vector>{
         query_relation<typename Attr::attribute_type, BindAttrs> ret{ query_operation::select };
 
-        ret.op_args.push_back(detail::column_full_names_to_string<Attr>());
-        ret.tables = std::move(this->tables);
+        ret.tokens = std::move(this->tokens);
+        ret.tokens.erase(query_clause::op_args);
+        ret.tokens.template push_fragment<&detail::column_full_names_to_string<Attr>>(query_clause::op_args);
 
-        ret.conditions = std::move(this->conditions);
-        ret.options = std::move(this->options);
         ret.bind_attrs = std::move(this->bind_attrs);
         return ret;
     }
@@ -107,11 +100,10 @@ namespace arcxx {
     inline auto query_relation<Result, BindAttrs>::pluck() const& requires specialized_from<Result, std::vector>{
         query_relation<typename Attr::attribute_type, BindAttrs> ret{ query_operation::select };
 
-        ret.op_args.push_back(detail::column_full_names_to_string<Attr>());
-        ret.tables = this->tables;
+        ret.tokens = this->tokens;
+        ret.tokens.erase(query_clause::op_args);
+        ret.tokens.template push_fragment<&detail::column_full_names_to_string<Attr>>(query_clause::op_args);
 
-        ret.conditions = this->conditions;
-        ret.options = this->options;
         ret.bind_attrs = this->bind_attrs;
         return ret;
     }
@@ -120,27 +112,29 @@ namespace arcxx {
     namespace detail {
         template<std::size_t N, typename Query, is_attribute Last>
         void set_update_op_args(Query& query, Last&& last) {
-            query.op_args.push_back(concat_strings("\"", Last::column_name, "\" = "));
-            query.op_args.push_back(N);
+            query.tokens.template push_fragment<&column_name_to_string<std::remove_cvref_t<Last>>>(query_clause::op_args);
+            query.tokens.push_static(query_clause::op_args, " = ");
+            query.tokens.push_bind(query_clause::op_args, N);
             std::get<N>(query.bind_attrs) = std::move(last);
         }
         template<std::size_t N, typename Query, is_attribute Head, is_attribute... Tails>
         void set_update_op_args(Query& query, Head&& head, Tails&&... tails) {
             set_update_op_args<N>(query, std::move(head));
-            query.op_args.push_back(",");
+            query.tokens.push_static(query_clause::op_args, ",");
             set_update_op_args<N + 1>(query, std::move(tails)...);
         }
 
         template<std::size_t N, typename Query, is_attribute Last>
         void set_update_op_args(Query& query, Last& last) {
-            query.op_args.push_back(concat_strings("\"", Last::column_name, "\" = "));
-            query.op_args.push_back(N);
+            query.tokens.template push_fragment<&column_name_to_string<std::remove_cvref_t<Last>>>(query_clause::op_args);
+            query.tokens.push_static(query_clause::op_args, " = ");
+            query.tokens.push_bind(query_clause::op_args, N);
             std::get<N>(query.bind_attrs) = last;
         }
         template<std::size_t N, typename Query, is_attribute Head, is_attribute... Tails>
         void set_update_op_args(Query& query, Head& head, Tails&... tails) {
             set_update_op_args<N>(query, head);
-            query.op_args.push_back(",");
+            query.tokens.push_static(query_clause::op_args, ",");
             set_update_op_args<N + 1>(query, tails...);
         }
     }
@@ -151,9 +145,10 @@ namespace arcxx {
     inline auto query_relation<Result, BindAttrs>::update(const Attrs&... attrs) && requires specialized_from<Result, std::vector>{
         query_relation<void, tuptup::tuple_cat_t<BindAttrs, std::tuple<Attrs...>>> ret{ query_operation::update };
 
-        ret.tables.push_back(concat_strings("\"", Result::value_type::table_name, "\""));
-        ret.conditions = std::move(this->conditions);
-        ret.options = std::move(this->options);
+        ret.tokens = std::move(this->tokens);
+        ret.tokens.erase(query_clause::op_args);
+        ret.tokens.erase(query_clause::tables);
+        ret.tokens.template push_fragment<&detail::table_name_to_string<typename Result::value_type>>(query_clause::tables);
         ret.bind_attrs = std::tuple_cat(std::move(this->bind_attrs), std::make_tuple(attrs...));
         detail::set_update_op_args<std::tuple_size_v<BindAttrs>>(ret, std::move(attrs)...);
         return ret;
@@ -164,9 +159,10 @@ namespace arcxx {
     inline auto query_relation<Result, BindAttrs>::update(const Attrs&... attrs) const& requires specialized_from<Result, std::vector>{
         query_relation<void, tuptup::tuple_cat_t<BindAttrs, std::tuple<Attrs...>>> ret{ query_operation::update };
 
-        ret.tables.push_back(concat_strings("\"", Result::value_type::table_name, "\""));
-        ret.conditions = this->conditions;
-        ret.options = this->options;
+        ret.tokens = this->tokens;
+        ret.tokens.erase(query_clause::op_args);
+        ret.tokens.erase(query_clause::tables);
+        ret.tokens.template push_fragment<&detail::table_name_to_string<typename Result::value_type>>(query_clause::tables);
         ret.bind_attrs = std::tuple_cat(this->bind_attrs, std::make_tuple(attrs...));
         detail::set_update_op_args<std::tuple_size_v<BindAttrs>>(ret, attrs...);
         return ret;
@@ -187,22 +183,11 @@ namespace arcxx {
     template<specialized_from<std::tuple> SrcBindAttrs>
     inline auto query_relation<Result, BindAttrs>::where(query_condition<SrcBindAttrs>&& cond) && requires specialized_from<Result, std::vector>{
         query_relation<Result, tuptup::tuple_cat_t<BindAttrs, SrcBindAttrs>> ret{ this->operation };
-        ret.op_args = std::move(this->op_args);
-        ret.tables = std::move(this->tables);
-        if(!this->conditions.empty()){
-            ret.conditions = std::move(this->conditions);
-            ret.conditions.reserve(ret.conditions.size() + cond.condition.size() + 1);
-            ret.conditions.push_back(" AND ");
+        ret.tokens = std::move(this->tokens);
+        if(!ret.tokens.empty(query_clause::conditions)){
+            ret.tokens.push_static(query_clause::conditions, " AND ");
         }
-        else ret.conditions.reserve(cond.condition.size());
-        for(auto& cond : cond.condition){
-            visit_by_lambda(std::move(cond),
-                [&ret_cond = ret.conditions](arcxx::string&& str) { ret_cond.push_back(std::move(str)); },
-                [&ret_cond = ret.conditions](const std::size_t idx) { ret_cond.push_back(idx + std::tuple_size_v<BindAttrs>); }
-            );
-        }
-
-        ret.options = std::move(this->options);
+        ret.tokens.append(cond.condition, std::tuple_size_v<BindAttrs>);
         ret.bind_attrs = std::tuple_cat(std::move(this->bind_attrs), std::move(cond.bind_attrs));
         return ret;
     }
@@ -211,38 +196,29 @@ namespace arcxx {
     template<specialized_from<std::tuple> SrcBindAttrs>
     inline auto query_relation<Result, BindAttrs>::where(query_condition<SrcBindAttrs>&& cond) const& requires specialized_from<Result, std::vector>{
         query_relation<Result, tuptup::tuple_cat_t<BindAttrs, SrcBindAttrs>> ret{ this->operation };
-        ret.op_args = this->op_args;
-        ret.tables = this->tables;
-        ret.conditions.reserve(this->conditions.size() + cond.condition.size() + !this->conditions.empty());
-        if(!this->conditions.empty()){
-            ret.conditions = this->conditions;
-            ret.conditions.push_back(" AND ");
-        }
-        for(auto& cond : cond.condition){
-            visit_by_lambda(std::move(cond),
-                [&ret_cond = ret.conditions](arcxx::string&& str) { ret_cond.push_back(std::move(str)); },
-                [&ret_cond = ret.conditions](const std::size_t idx) { ret_cond.push_back(idx + std::tuple_size_v<BindAttrs>); }
-            );
+        ret.tokens = this->tokens;
+        if(!ret.tokens.empty(query_clause::conditions)){
+            ret.tokens.push_static(query_clause::conditions, " AND ");
         }
-        ret.options = this->options;
+        ret.tokens.append(cond.condition, std::tuple_size_v<BindAttrs>);
         ret.bind_attrs = std::tuple_cat(this->bind_attrs, std::move(cond.bind_attrs));
         return ret;
     }
 
     template<typename Result, specialized_from<std::tuple> BindAttrs>
     inline auto query_relation<Result, BindAttrs>::limit(const std::size_t lim) && requires specialized_from<Result, std::vector>{
-        this->options.push_back(concat_strings(" LIMIT ", std::to_string(lim)));
+        this->static_sql = {};
+        this->tokens.push_static(query_clause::options, " LIMIT ");
+        this->tokens.push_number(query_clause::options, lim);
         return *this;
     }
     template<typename Result, specialized_from<std::tuple> BindAttrs>
     inline auto query_relation<Result, BindAttrs>::limit(const std::size_t lim) const& requires specialized_from<Result, std::vector>{
         query_relation<Result, BindAttrs> ret{ this->operation };
 
-        ret.op_args = this->op_args;
-        ret.tables = this->tables;
-        ret.conditions = this->conditions;
-        ret.options = this->options;
-        ret.options.push_back(concat_strings(" LIMIT ", std::to_string(lim)));
+        ret.tokens = this->tokens;
+        ret.tokens.push_static(query_clause::options, " LIMIT ");
+        ret.tokens.push_number(query_clause::options, lim);
         ret.bind_attrs = this->bind_attrs;
 
         return ret;
@@ -251,10 +227,11 @@ namespace arcxx {
     template<typename Result, specialized_from<std::tuple> BindAttrs>
     template<is_attribute Attr>
     inline auto query_relation<Result, BindAttrs>::order_by(const arcxx::order order) && requires specialized_from<Result, std::vector>{
-        this->options.push_back(concat_strings(
-            " ORDER BY ", detail::column_full_names_to_string<Attr>(),
-            order == arcxx::order::asc ? " ASC" : " DESC"
-        ));
+        this->static_sql = {};
+        this->tokens.push_static(query_clause::options, " ORDER BY ");
+        this->tokens.template push_fragment<&detail::column_full_names_to_string<Attr>>(query_clause::options);
+        if(order == arcxx::order::asc) this->tokens.push_static(query_clause::options, " ASC");
+        else this->tokens.push_static(query_clause::options, " DESC");
 
         return *this;
     }
@@ -263,16 +240,13 @@ namespace arcxx {
     inline auto query_relation<Result, BindAttrs>::order_by(const arcxx::order order) const& requires specialized_from<Result, std::vector>{
         query_relation<Result, BindAttrs> ret{ this->operation };
 
-        ret.op_args = this->op_args;
-        ret.tables = this->tables;
-        ret.conditions = this->conditions;
+        ret.tokens = this->tokens;
         ret.bind_attrs = this->bind_attrs;
-        ret.options = this->options;
 
-        ret.options.push_back(concat_strings(
-            " ORDER BY ", detail::column_full_names_to_string<Attr>(),
-            order == arcxx::order::asc ? " ASC" : " DESC"
-        ));
+        ret.tokens.push_static(query_clause::options, " ORDER BY ");
+        ret.tokens.template push_fragment<&detail::column_full_names_to_string<Attr>>(query_clause::options);
+        if(order == arcxx::order::asc) ret.tokens.push_static(query_clause::options, " ASC");
+        else ret.tokens.push_static(query_clause::options, " DESC");
 
         return ret;
     }
@@ -281,11 +255,10 @@ namespace arcxx {
     inline auto query_relation<Result, BindAttrs>::count() && requires specialized_from<Result, std::vector>{
         query_relation<std::size_t, BindAttrs> ret{ query_operation::select };
 
-        ret.op_args.push_back("count(*)");
-        ret.tables = std::move(this->tables);
-        ret.conditions = std::move(this->conditions);
+        ret.tokens = std::move(this->tokens);
+        ret.tokens.erase(query_clause::op_args);
+        ret.tokens.template push_fragment<&detail::count_all_to_string>(query_clause::op_args);
         ret.bind_attrs = std::move(this->bind_attrs);
-        ret.options = std::move(this->options);
 
         return ret;
     }
@@ -293,11 +266,10 @@ namespace arcxx {
     inline auto query_relation<Result, BindAttrs>::count() const& requires specialized_from<Result, std::vector>{
         query_relation<std::size_t, BindAttrs> ret{ query_operation::select };
 
-        ret.op_args.push_back("count(*)");
-        ret.tables = this->tables;
-        ret.conditions = this->conditions;
+        ret.tokens = this->tokens;
+        ret.tokens.erase(query_clause::op_args);
+        ret.tokens.template push_fragment<&detail::count_all_to_string>(query_clause::op_args);
         ret.bind_attrs = this->bind_attrs;
-        ret.options = this->options;
 
         return ret;
     }
@@ -307,11 +279,10 @@ namespace arcxx {
         query_relation<typename T::attribute_type, BindAttrs> vectored_aggregate_query(const query_relation<Result, BindAttrs>& src) {
             query_relation<typename T::attribute_type, BindAttrs> ret{ query_operation::select };
 
-            ret.op_args.push_back(T::column_full_name());
-            ret.tables = src.tables;
-            ret.conditions = src.conditions;
+            ret.tokens = src.tokens;
+            ret.tokens.erase(query_clause::op_args);
+            ret.tokens.template push_fragment<&T::column_full_name>(query_clause::op_args);
             ret.bind_attrs = src.bind_attrs;
-            ret.options = src.options;
 
             return ret;
         }
@@ -320,11 +291,10 @@ namespace arcxx {
         query_relation<typename T::attribute_type, BindAttrs> vectored_aggregate_query(query_relation<Result, BindAttrs>&& src) {
             query_relation<typename T::attribute_type, BindAttrs> ret{ query_operation::select };
 
-            ret.op_args.push_back(T::column_full_name());
-            ret.tables = std::move(src.tables);
-            ret.conditions = std::move(src.conditions);
+            ret.tokens = std::move(src.tokens);
+            ret.tokens.erase(query_clause::op_args);
+            ret.tokens.template push_fragment<&T::column_full_name>(query_clause::op_args);
             ret.bind_attrs = std::move(src.bind_attrs);
-            ret.options = std::move(src.options);
 
             return ret;
         }
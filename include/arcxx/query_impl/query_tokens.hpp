@@ -0,0 +1,261 @@
+#pragma once
+/*
+ * ARCXX: https://github.com/akisute514/arcxx
+ * Copyright (c) 2021 akisute514
+ *
+ * Released under the MIT License.
+ */
+#include "../utils.hpp"
+
+namespace arcxx {
+    enum class query_clause : std::uint8_t {
+        op_args,
+        tables,
+        conditions,
+        options // order, limit
+    };
+
+    // string_view which refers to static storage. It is checked at compile time.
+    class static_string_view {
+        arcxx::string_view str;
+    public:
+        template<std::size_t N>
+        consteval static_string_view(built_in_string_literal<N> s) noexcept : str(s, N-1) {}
+        template<std::size_t N>
+        consteval static_string_view(const string_literal<N>& s) noexcept : str(s.c_str(), N-1) {}
+
+        constexpr operator arcxx::string_view() const noexcept {
+            return str;
+        }
+    };
+
+    namespace detail {
+        // static storage for fragments computed at compile time
+        template<auto Fragment>
+        inline constexpr auto static_fragment = Fragment();
+
+        [[nodiscard]] inline constexpr std::uint64_t hash_combine(const std::uint64_t seed, const std::uint64_t value) noexcept {
+            // splitmix64 finalizer
+            std::uint64_t x = seed ^ (value + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2));
+            x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+            x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+            return x ^ (x >> 31);
+        }
+    }
+
+    struct query_token {
+        enum class kind_type : std::uint8_t {
+            static_text,
+            owned_text,
+            bind
+        };
+        query_clause clause;
+        kind_type kind;
+        std::uint32_t length;
+        // static_text : pointer to text
+        // owned_text  : offset in query_tokens::owned_texts
+        // bind        : index of bind attributes
+        union {
+            const typename arcxx::string::value_type* text;
+            std::size_t offset;
+            std::size_t index;
+        };
+    };
+
+    /*
+     * Tokens of all clauses of SQL statement.
+     * Static fragments are referred without copying, others are copied into one buffer.
+     * Tokens are kept grouped by clause, so that each clause is a contiguous range.
+     */
+    class query_tokens {
+        static constexpr std::size_t clause_count = static_cast<std::size_t>(query_clause::options) + 1;
+
+        arcxx::vector<query_token> tokens;
+        arcxx::string owned_texts;
+        // end of range of each clause in tokens
+        std::array<std::uint32_t, clause_count> clause_ends = {};
+        // whether values which vary between executions (e.g. LIMIT) are copied as texts
+        bool has_literals = false;
+
+        /*
+         * Structural hash of each clause, updated whenever a token is added.
+         * It is a polynomial hash of token hashes (hash = sum of token_hash * base^(distance from end)),
+         * so that appending tokens of another query_tokens is O(1) for each clause.
+         * Token hash of bind is linear in its index, so that shifted bind indices are applied by bind_weight.
+         */
+        struct clause_hash {
+            std::uint64_t hash = 0;
+            std::uint64_t bind_weight = 0; // sum of base^(distance from end) of bind tokens
+            std::uint64_t power = 1;       // base^(number of tokens)
+        };
+        static constexpr std::uint64_t hash_base = 0x100000001b3;
+        static constexpr std::uint64_t bind_hash_seed = 0x2545f4914f6cdd1d;
+        static constexpr std::uint64_t bind_hash_step = 0x9e3779b97f4a7c15;
+        std::array<clause_hash, clause_count> clause_hashes = {};
+
+        [[nodiscard]] static constexpr std::size_t to_index(const query_clause clause) noexcept {
+            return static_cast<std::size_t>(clause);
+        }
+        [[nodiscard]] std::size_t clause_begin(const query_clause clause) const noexcept {
+            return clause == query_clause::op_args ? 0 : clause_ends[to_index(clause) - 1];
+        }
+        void grow_clause(const query_clause clause, const std::size_t n) noexcept {
+            for(auto i = to_index(clause); i < clause_count; ++i) clause_ends[i] += static_cast<std::uint32_t>(n);
+        }
+        [[nodiscard]] arcxx::string_view text_of(const query_token& token) const noexcept {
+            if(token.kind == query_token::kind_type::static_text) return { token.text, token.length };
+            else return { owned_texts.data() + token.offset, token.length };
+        }
+        // Static texts are identified by their address, which is stable in a process.
+        [[nodiscard]] std::uint64_t token_hash(const query_token& token) const noexcept {
+            switch(token.kind) {
+            case query_token::kind_type::static_text:
+                return detail::hash_combine(reinterpret_cast<std::uintptr_t>(token.text), token.length);
+            case query_token::kind_type::owned_text:
+                return detail::hash_combine(std::hash<arcxx::string_view>{}(text_of(token)), token.length);
+            case query_token::kind_type::bind:
+            default:
+                return bind_hash_seed + token.index * bind_hash_step;
+            }
+        }
+        void push(const query_token& token) {
+            const auto pos = tokens.begin() + clause_ends[to_index(token.clause)];
+            // tokens are mostly pushed in order of clauses
+            if(pos == tokens.end()) tokens.push_back(token);
+            else tokens.insert(pos, token);
+            grow_clause(token.clause, 1);
+
+            auto& h = clause_hashes[to_index(token.clause)];
+            h.hash = h.hash * hash_base + token_hash(token);
+            h.bind_weight = h.bind_weight * hash_base + (token.kind == query_token::kind_type::bind ? 1 : 0);
+            h.power *= hash_base;
+        }
+    public:
+        void reserve(const std::size_t n) {
+            tokens.reserve(n);
+        }
+
+        void push_static(const query_clause clause, const static_string_view str) {
+            const arcxx::string_view sv = str;
+            query_token token{ clause, query_token::kind_type::static_text, static_cast<std::uint32_t>(sv.size()), {} };
+            token.text = sv.data();
+            push(token);
+        }
+        void push_copy(const query_clause clause, const arcxx::string_view str) {
+            query_token token{ clause, query_token::kind_type::owned_text, static_cast<std::uint32_t>(str.size()), {} };
+            token.offset = owned_texts.size();
+            owned_texts += str;
+            push(token);
+        }
+        // Copy a text which is a value rather than a part of the structure, e.g. raw SQL.
+        void push_literal(const query_clause clause, const arcxx::string_view str) {
+            push_copy(clause, str);
+            has_literals = true;
+        }
+        void push_number(const query_clause clause, const std::size_t num) {
+            std::array<typename arcxx::string::value_type, std::numeric_limits<std::size_t>::digits10 + 2> char_buff;
+            const auto [end, ec] = std::to_chars(std::to_address(char_buff.begin()), std::to_address(char_buff.end()), num);
+            push_literal(clause, arcxx::string_view{ char_buff.data(), static_cast<std::size_t>(end - char_buff.data()) });
+        }
+        void push_bind(const query_clause clause, const std::size_t idx) {
+            query_token token{ clause, query_token::kind_type::bind, 0, {} };
+            token.index = idx;
+            push(token);
+        }
+        // Fragment is a function which returns a string literal (computed at compile time) or a string
+        template<auto Fragment>
+        void push_fragment(const query_clause clause) {
+            if constexpr(detail::is_string_literal<decltype(Fragment())>) {
+                push_static(clause, detail::static_fragment<Fragment>);
+            }
+            else {
+                push_copy(clause, Fragment());
+            }
+        }
+
+        // Append all tokens of src to the end of each clause. Bind indices of src are shifted by bind_offset.
+        void append(const query_tokens& src, const std::size_t bind_offset) {
+            const std::size_t text_offset = owned_texts.size();
+            owned_texts += src.owned_texts;
+            has_literals = has_literals || src.has_literals;
+            tokens.reserve(tokens.size() + src.tokens.size());
+            for(std::size_t i = 0; i < clause_count; ++i) {
+                const auto clause = static_cast<query_clause>(i);
+                const auto first = src.tokens.begin() + src.clause_begin(clause);
+                const auto last = src.tokens.begin() + src.clause_ends[i];
+                if(first == last) continue;
+
+                const auto pos = tokens.insert(tokens.begin() + clause_ends[i], first, last);
+                for(auto& token : std::ranges::subrange(pos, pos + (last - first))) {
+                    if(token.kind == query_token::kind_type::owned_text) token.offset += text_offset;
+                    else if(token.kind == query_token::kind_type::bind) token.index += bind_offset;
+                }
+                grow_clause(clause, static_cast<std::size_t>(last - first));
+
+                auto& h = clause_hashes[i];
+                const auto& src_h = src.clause_hashes[i];
+                h.hash = h.hash * src_h.power + src_h.hash + bind_offset * bind_hash_step * src_h.bind_weight;
+                h.bind_weight = h.bind_weight * src_h.power + src_h.bind_weight;
+                h.power *= src_h.power;
+            }
+        }
+
+        void erase(const query_clause clause) {
+            const auto first = clause_begin(clause);
+            const auto last = clause_ends[to_index(clause)];
+            tokens.erase(tokens.begin() + first, tokens.begin() + last);
+            for(auto i = to_index(clause); i < clause_count; ++i) clause_ends[i] -= last - first;
+            clause_hashes[to_index(clause)] = {};
+        }
+
+        [[nodiscard]] bool empty() const noexcept {
+            return tokens.empty();
+        }
+        // Whether rendered SQL is worth caching by fingerprint. Literals make a fingerprint for each value.
+        [[nodiscard]] bool cacheable() const noexcept {
+            return !has_literals;
+        }
+        [[nodiscard]] bool empty(const query_clause clause) const noexcept {
+            return clause_begin(clause) == clause_ends[to_index(clause)];
+        }
+
+        // Tokens which have the same fingerprint render the same SQL on bindable connectors (except for hash collisions).
+        [[nodiscard]] std::uint64_t fingerprint() const noexcept {
+            std::uint64_t hash = 0;
+            for(const auto& h : clause_hashes) hash = detail::hash_combine(detail::hash_combine(hash, h.hash), h.power);
+            return hash;
+        }
+
+        // Structural equality. Bind indices are compared but bound values are not.
+        [[nodiscard]] friend bool operator==(const query_tokens& lhs, const query_tokens& rhs) noexcept {
+            return lhs.clause_ends == rhs.clause_ends && std::ranges::equal(lhs.tokens, rhs.tokens,
+                [&lhs, &rhs](const query_token& l, const query_token& r) noexcept {
+                    if(l.clause != r.clause || (l.kind == query_token::kind_type::bind) != (r.kind == query_token::kind_type::bind)) return false;
+                    else if(l.kind == query_token::kind_type::bind) return l.index == r.index;
+                    else if(l.kind == query_token::kind_type::static_text && r.kind == query_token::kind_type::static_text && l.text == r.text) return l.length == r.length;
+                    else return lhs.text_of(l) == rhs.text_of(r);
+                }
+            );
+        }
+
+        // Call on_text(string_view) or on_bind(index) for each token of clause in order
+        template<std::invocable<arcxx::string_view> TextFunc, std::invocable<std::size_t> BindFunc>
+        void visit(const query_clause clause, TextFunc&& on_text, BindFunc&& on_bind) const {
+            const auto last = tokens.begin() + clause_ends[to_index(clause)];
+            for(auto it = tokens.begin() + clause_begin(clause); it != last; ++it) {
+                switch(it->kind) {
+                case query_token::kind_type::static_text:
+                    on_text(arcxx::string_view{ it->text, it->length });
+                    break;
+                case query_token::kind_type::owned_text:
+                    on_text(arcxx::string_view{ owned_texts.data() + it->offset, it->length });
+                    break;
+                case query_token::kind_type::bind:
+                default:
+                    on_bind(it->index);
+                    break;
+                }
+            }
+        }
+    };
+}
@@ -7,28 +7,80 @@
  */
 #include "../model.hpp"
 namespace arcxx::detail {
+    template<is_attribute Attr>
+    [[nodiscard]] inline constexpr auto column_name_to_string(){
+        if constexpr(constant_string_getter<column_name_getter<Attr>>) {
+            return concat_strings("\"", to_string_literal(column_name_getter<Attr>{}).c_str(), "\"");
+        }
+        else {
+            return concat_strings("\"", Attr::column_name, "\"");
+        }
+    }
+
+    template<typename Last>
+    [[nodiscard]] inline constexpr auto column_names_to_string(){
+        return column_name_to_string<Last>();
+    }
+    template<typename Head, typename... Tail>
+    requires (sizeof...(Tail) > 0)
+    [[nodiscard]] inline constexpr auto column_names_to_string(){
+        return concat_strings(column_names_to_string<Head>().c_str(), ",", column_names_to_string<Tail...>().c_str());
+    }
+
+    // "column" = Source."column", e.g. Source is "excluded" of upsert
+    template<basic_string_literal Source, is_attribute Attr>
+    [[nodiscard]] inline constexpr auto assignment_from_to_string(){
+        if constexpr(is_string_literal<decltype(column_name_to_string<Attr>())>) {
+            return concat_strings(column_name_to_string<Attr>().c_str(), " = ", Source.c_str(), ".", column_name_to_string<Attr>().c_str());
+        }
+        else {
+            return concat_strings(column_name_to_string<Attr>(), " = ", Source, ".", column_name_to_string<Attr>());
+        }
+    }
+
+    template<basic_string_literal Source, typename Last>
+    [[nodiscard]] inline constexpr auto assignments_from_to_string(){
+        return assignment_from_to_string<Source, Last>();
+    }
+    template<basic_string_literal Source, typename Head, typename... Tail>
+    requires (sizeof...(Tail) > 0)
+    [[nodiscard]] inline constexpr auto assignments_from_to_string(){
+        return concat_strings(assignments_from_to_string<Source, Head>().c_str(), ",", assignments_from_to_string<Source, Tail...>().c_str());
+    }
+
     template<is_model Mod>
-    inline arcxx::string insert_column_names_to_string() {
-        arcxx::string table;
-        const auto column_names = Mod::column_names();
-        table.reserve([&column_names]() constexpr {
-            return std::transform_reduce(
+    [[nodiscard]] inline constexpr auto insert_column_names_to_string(){
+        using namespace tuptup::type_placeholders;
+        using attributes_t = tuptup::apply_type_t<std::remove_cvref<_1>, decltype(Mod{}.attributes_as_tuple())>;
+        using column_names_t = decltype([]<typename... Attrs>(std::tuple<Attrs...>*){ return column_names_to_string<Attrs...>(); }(static_cast<attributes_t*>(nullptr)));
+
+        if constexpr(is_string_literal<column_names_t> && constant_string_getter<table_name_getter<Mod>>) {
+            return concat_strings(
+                "\"", to_string_literal(table_name_getter<Mod>{}).c_str(), "\"(",
+                []<typename... Attrs>(std::tuple<Attrs...>*){ return column_names_to_string<Attrs...>(); }(static_cast<attributes_t*>(nullptr)).c_str(),
+                ")"
+            );
+        }
+        else {
+            arcxx::string table;
+            const auto column_names = Mod::column_names();
+            table.reserve(std::transform_reduce(
                 column_names.begin(), column_names.end(), static_cast<std::size_t>(0),
                 [](auto acc, const auto len){ return acc += len; },
                 [](const auto& str){ return str.length(); }
-            ) + column_names.size() * 3 + 4 + static_cast<arcxx::string_view>(Mod::table_name).length();
-        }());
-        table += concat_strings("\"", Mod::table_name, "\"(");
-        arcxx::string_view delimiter = "";
-        for (const auto& col_name : column_names) {
-            table += delimiter;
-            table += "\"";
-            table += col_name;
-            table += "\"";
-            delimiter = ",";
+            ) + column_names.size() * 3 + 4 + static_cast<arcxx::string_view>(Mod::table_name).length());
+            table += concat_strings("\"", Mod::table_name, "\"(");
+            arcxx::string_view delimiter = "";
+            for (const auto& col_name : column_names) {
+                table += delimiter;
+                table += "\"";
+                table += col_name;
+                table += "\"";
+                delimiter = ",";
+            }
+            table += ")";
+            return table;
         }
-        table += ")";
-        return table;
     }
 
     template<typename Last>
@@ -41,26 +93,165 @@ namespace arcxx::detail {
         return concat_strings(column_full_names_to_string<Head>().c_str(), ",", column_full_names_to_string<Tail...>().c_str());
     }
 
+    // "table"."column" = Source."column"
+    template<basic_string_literal Source, is_attribute Attr>
+    [[nodiscard]] inline constexpr auto equal_from_to_string(){
+        if constexpr(is_string_literal<decltype(column_full_names_to_string<Attr>())> && is_string_literal<decltype(column_name_to_string<Attr>())>) {
+            return concat_strings(column_full_names_to_string<Attr>().c_str(), " = ", Source.c_str(), ".", column_name_to_string<Attr>().c_str());
+        }
+        else {
+            return concat_strings(column_full_names_to_string<Attr>(), " = ", Source, ".", column_name_to_string<Attr>());
+        }
+    }
+
+    template<basic_string_literal Source, typename Last>
+    [[nodiscard]] inline constexpr auto equals_from_to_string(){
+        return equal_from_to_string<Source, Last>();
+    }
+    template<basic_string_literal Source, typename Head, typename... Tail>
+    requires (sizeof...(Tail) > 0)
+    [[nodiscard]] inline constexpr auto equals_from_to_string(){
+        return concat_strings(equals_from_to_string<Source, Head>().c_str(), " AND ", equals_from_to_string<Source, Tail...>().c_str());
+    }
+
     template<is_model Mod>
-    [[nodiscard]] inline arcxx::string model_column_full_names_to_string(){
-        const auto column_names = Mod::column_names();
-        arcxx::string buff;
-        const std::size_t buff_size = std::transform_reduce(
-            column_names.begin(), column_names.end(), static_cast<std::size_t>(0),
-            [](auto acc, const auto len) constexpr { return acc += len; },
-            [](const auto& str) constexpr { return str.length() + static_cast<arcxx::string_view>(Mod::table_name).length() + 6; }
-        );
-        buff.reserve(buff_size);
-        arcxx::string_view delimiter = "";
-        for (const auto& col_name : column_names) {
-            buff += delimiter;
-            buff += "\"";
-            buff += Mod::table_name;
-            buff += "\".\"";
-            buff += col_name;
-            buff += "\"";
-            delimiter = ",";
-        }
-        return buff;
+    [[nodiscard]] inline constexpr auto model_column_full_names_to_string(){
+        using namespace tuptup::type_placeholders;
+        using attributes_t = tuptup::apply_type_t<std::remove_cvref<_1>, decltype(Mod{}.attributes_as_tuple())>;
+        using column_full_names_t = decltype([]<typename... Attrs>(std::tuple<Attrs...>*){ return column_full_names_to_string<Attrs...>(); }(static_cast<attributes_t*>(nullptr)));
+
+        if constexpr(is_string_literal<column_full_names_t>) {
+            return []<typename... Attrs>(std::tuple<Attrs...>*){ return column_full_names_to_string<Attrs...>(); }(static_cast<attributes_t*>(nullptr));
+        }
+        else {
+            const auto column_names = Mod::column_names();
+            arcxx::string buff;
+            const std::size_t buff_size = std::transform_reduce(
+                column_names.begin(), column_names.end(), static_cast<std::size_t>(0),
+                [](auto acc, const auto len) constexpr { return acc += len; },
+                [](const auto& str) constexpr { return str.length() + static_cast<arcxx::string_view>(Mod::table_name).length() + 6; }
+            );
+            buff.reserve(buff_size);
+            arcxx::string_view delimiter = "";
+            for (const auto& col_name : column_names) {
+                buff += delimiter;
+                buff += "\"";
+                buff += Mod::table_name;
+                buff += "\".\"";
+                buff += col_name;
+                buff += "\"";
+                delimiter = ",";
+            }
+            return buff;
+        }
     }
+
+    template<is_model Mod>
+    [[nodiscard]] inline constexpr auto table_name_to_string(){
+        if constexpr(constant_string_getter<table_name_getter<Mod>>) {
+            return concat_strings("\"", to_string_literal(table_name_getter<Mod>{}).c_str(), "\"");
+        }
+        else {
+            return concat_strings("\"", Mod::table_name, "\"");
+        }
+    }
+
+    // JoinType is "INNER JOIN" or "LEFT OUTER JOIN"
+    template<is_model Mod, is_attribute ReferenceAttribute, basic_string_literal JoinType>
+    [[nodiscard]] inline constexpr auto join_tables_to_string(){
+        using reference_model = typename ReferenceAttribute::foreign_key_type::model_type;
+        using fk_column_t = decltype(column_full_names_to_string<typename ReferenceAttribute::foreign_key_type>());
+        using column_t = decltype(column_full_names_to_string<ReferenceAttribute>());
+
+        if constexpr(is_string_literal<fk_column_t> && is_string_literal<column_t>
+            && constant_string_getter<table_name_getter<Mod>> && constant_string_getter<table_name_getter<reference_model>>) {
+            return concat_strings(
+                table_name_to_string<Mod>().c_str(), " ", JoinType.c_str(), " ", table_name_to_string<reference_model>().c_str(),
+                " ON ", column_full_names_to_string<typename ReferenceAttribute::foreign_key_type>().c_str(),
+                " = ", column_full_names_to_string<ReferenceAttribute>().c_str()
+            );
+        }
+        else {
+            return concat_strings(
+                table_name_to_string<Mod>(), " ", JoinType, " ", table_name_to_string<reference_model>(),
+                " ON ", column_full_names_to_string<typename ReferenceAttribute::foreign_key_type>(),
+                " = ", column_full_names_to_string<ReferenceAttribute>()
+            );
+        }
+    }
+
+    template<is_attribute Attr>
+    [[nodiscard]] inline constexpr auto group_by_to_string(){
+        if constexpr(is_string_literal<decltype(column_full_names_to_string<Attr>())>) {
+            return concat_strings("GROUP BY", column_full_names_to_string<Attr>().c_str());
+        }
+        else {
+            return concat_strings("GROUP BY", column_full_names_to_string<Attr>());
+        }
+    }
+
+    template<is_attribute Attr, arcxx::order Order>
+    [[nodiscard]] inline constexpr auto order_by_to_string(){
+        if constexpr(!is_string_literal<decltype(column_full_names_to_string<Attr>())>) {
+            return concat_strings("ORDER BY ", column_full_names_to_string<Attr>(), Order == arcxx::order::asc ? " ASC" : " DESC");
+        }
+        else if constexpr(Order == arcxx::order::asc) {
+            return concat_strings("ORDER BY ", column_full_names_to_string<Attr>().c_str(), " ASC");
+        }
+        else {
+            return concat_strings("ORDER BY ", column_full_names_to_string<Attr>().c_str(), " DESC");
+        }
+    }
+
+    [[nodiscard]] inline constexpr auto count_all_to_string(){
+        return concat_strings("count(*)");
+    }
+
+    [[nodiscard]] inline constexpr auto empty_to_string(){
+        return concat_strings("");
+    }
+
+    template<auto Columns, auto Tables, auto Options>
+    inline constexpr auto static_select_statement = concat_strings("SELECT ", Columns.c_str(), " FROM ", Tables.c_str(), " ", Options.c_str(), ";");
+
+    /*
+     * Select statement rendered at compile time from fragment functions.
+     * Same as query_relation_common::to_sql renders from these fragments without conditions.
+     * Returns empty string_view if some fragments can not be computed at compile time.
+     */
+    template<auto ColumnsFunc, auto TablesFunc, auto OptionsFunc = &empty_to_string>
+    [[nodiscard]] inline constexpr arcxx::string_view static_select_sql() noexcept {
+        if constexpr(is_string_literal<decltype(ColumnsFunc())> && is_string_literal<decltype(TablesFunc())> && is_string_literal<decltype(OptionsFunc())>) {
+            return static_select_statement<ColumnsFunc(), TablesFunc(), OptionsFunc()>;
+        }
+        else {
+            return {};
+        }
+    }
+
+    /*
+     * Default conflict target of upsert.
+     * It is primary key attributes, or the first unique attribute if the model has no primary key.
+     */
+    template<typename... Attrs>
+    auto primary_key_attributes(std::tuple<Attrs...>*)
+        -> decltype(std::tuple_cat(std::declval<std::conditional_t<Attrs::has_constraint(Attrs::primary_key), std::tuple<Attrs>, std::tuple<>>>()...));
+    template<typename... Attrs>
+    auto unique_attributes(std::tuple<Attrs...>*)
+        -> decltype(std::tuple_cat(std::declval<std::conditional_t<Attrs::has_constraint(Attrs::unique), std::tuple<Attrs>, std::tuple<>>>()...));
+
+    template<specialized_from<std::tuple> Attrs>
+    struct default_conflict_target {
+        using primary_keys = decltype(primary_key_attributes(static_cast<Attrs*>(nullptr)));
+        using uniques = decltype(unique_attributes(static_cast<Attrs*>(nullptr)));
+        using type = std::conditional_t<
+            (std::tuple_size_v<primary_keys> > 0) || (std::tuple_size_v<uniques> == 0),
+            primary_keys,
+            std::tuple<std::tuple_element_t<0, std::conditional_t<(std::tuple_size_v<uniques> > 0), uniques, std::tuple<void>>>>
+        >;
+    };
+
+    template<typename... Attrs, typename... Excludes>
+    auto attributes_except(std::tuple<Attrs...>*, std::tuple<Excludes...>*)
+        -> decltype(std::tuple_cat(std::declval<std::conditional_t<tuptup::contains_in_tuple<Attrs, std::tuple<Excludes...>>::value, std::tuple<>, std::tuple<Attrs>>>()...));
 }
\ No newline at end of file
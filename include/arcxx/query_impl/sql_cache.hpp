@@ -0,0 +1,69 @@
+#pragma once
+/*
+ * ARCXX: https://github.com/akisute514/arcxx
+ * Copyright (c) 2021 akisute514
+ *
+ * Released under the MIT License.
+ */
+#include <mutex>
+#include <shared_mutex>
+#include "../query.hpp"
+#include "../connector.hpp"
+#include "query_tokens.hpp"
+
+namespace arcxx {
+    /*
+     * Process-wide cache of rendered SQL for each connector, keyed by query_relation_common::fingerprint().
+     * Only bindable connectors use it because their SQL does not contain bound values.
+     * Entries are never evicted, so returned string_views are valid until the process ends.
+     */
+    template<is_connector Connector>
+    class sql_cache {
+        struct entry {
+            query_operation operation;
+            query_tokens tokens;
+            arcxx::string sql;
+        };
+
+        inline static std::shared_mutex mtx;
+        inline static std::unordered_map<std::uint64_t, entry> entries;
+        inline static std::size_t max_size = 4096;
+    public:
+        sql_cache() = delete;
+
+        // Returns empty if not cached.
+        [[nodiscard]] static std::optional<arcxx::string_view> find(const std::uint64_t fingerprint, const query_operation operation, const query_tokens& tokens) {
+            const std::shared_lock lock{ mtx };
+            const auto it = entries.find(fingerprint);
+            // tokens are compared to exclude hash collisions
+            if(it == entries.end() || it->second.operation != operation || it->second.tokens != tokens) return std::nullopt;
+            return it->second.sql;
+        }
+
+        // Returns cached SQL, or empty if the cache is full or another statement has the same fingerprint.
+        [[nodiscard]] static std::optional<arcxx::string_view> insert(const std::uint64_t fingerprint, const query_operation operation, const query_tokens& tokens, const arcxx::string_view sql) {
+            const std::unique_lock lock{ mtx };
+            if(const auto it = entries.find(fingerprint); it != entries.end()) {
+                if(it->second.operation != operation || it->second.tokens != tokens) return std::nullopt;
+                return it->second.sql;
+            }
+            if(entries.size() >= max_size) return std::nullopt;
+            const pmr::global_scope scope{};
+            return entries.emplace(fingerprint, entry{ operation, tokens, arcxx::string{ sql } }).first->second.sql;
+        }
+
+        [[nodiscard]] static std::size_t size() {
+            const std::shared_lock lock{ mtx };
+            return entries.size();
+        }
+        [[nodiscard]] static std::size_t capacity() {
+            const std::shared_lock lock{ mtx };
+            return max_size;
+        }
+        // Limits the number of cached statements. 0 disables caching of new statements.
+        static void set_capacity(const std::size_t n) {
+            const std::unique_lock lock{ mtx };
+            max_size = n;
+        }
+    };
+}
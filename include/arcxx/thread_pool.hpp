@@ -0,0 +1,188 @@
+#pragma once
+/*
+ * ARCXX: https://github.com/akisute514/arcxx
+ * Copyright (c) 2021 akisute514
+ *
+ * Released under the MIT License.
+ */
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "utils.hpp"
+
+namespace arcxx {
+    /*
+     * Small work-stealing thread pool.
+     * Each worker has a queue of tasks, and idle workers steal tasks from the other queues.
+     * Tasks submitted by a worker are pushed to its own queue, and others are distributed in round-robin order.
+     */
+    class thread_pool {
+    private:
+        struct task_queue {
+            std::mutex mtx;
+            // the owner pops the back and thieves pop the front
+            std::deque<std::function<void()>> tasks;
+        };
+
+        std::vector<std::unique_ptr<task_queue>> queues;
+        std::vector<std::thread> workers;
+        std::mutex sleep_mtx;
+        std::condition_variable wake;
+        // number of tasks in queues and being pushed, which is increased with sleep_mtx so that no wake-up is missed
+        std::atomic<std::size_t> pending = 0;
+        std::atomic<std::size_t> next_queue = 0;
+        bool stopping = false;
+        // number of threads sleeping in wait(), which are woken when a task completes
+        std::size_t waiters = 0;
+        // queue index of the worker running on this thread
+        inline static thread_local std::pair<const thread_pool*, std::size_t> current_worker = { nullptr, 0 };
+
+        void push(std::function<void()>&& task);
+        // Pop a task of the queue at index, or steal one from the other queues.
+        std::optional<std::function<void()>> pop(const std::size_t index);
+        void work(const std::size_t index);
+    public:
+        // 0 is std::thread::hardware_concurrency().
+        explicit thread_pool(const std::size_t threads = 0);
+        thread_pool(const thread_pool&) = delete;
+        thread_pool(thread_pool&&) = delete;
+        // Run remaining tasks and join workers.
+        ~thread_pool();
+
+        template<typename F>
+        requires std::invocable<F&>
+        [[nodiscard]] std::future<std::invoke_result_t<F&>> submit(F&& func);
+
+        // Run a pending task on the calling thread, e.g. while waiting for a future. Returns false if there is none.
+        bool run_pending_task();
+        // Wait for the future of a task of the pool, running pending tasks on the calling thread meanwhile.
+        // It sleeps while there is no pending task, until a task completes or is pushed.
+        template<typename T>
+        T wait(std::future<T>& future);
+
+        std::size_t size() const noexcept;
+        // pool shared by the process, whose size is std::thread::hardware_concurrency()
+        static thread_pool& shared();
+    };
+
+    inline thread_pool::thread_pool(const std::size_t threads) {
+        const std::size_t count = threads != 0 ? threads : std::max(std::thread::hardware_concurrency(), 1u);
+        queues.reserve(count);
+        for(std::size_t i = 0; i < count; ++i) queues.push_back(std::make_unique<task_queue>());
+        workers.reserve(count);
+        for(std::size_t i = 0; i < count; ++i) workers.emplace_back([this, i]{ work(i); });
+    }
+    inline thread_pool::~thread_pool() {
+        {
+            std::lock_guard lock{ sleep_mtx };
+            stopping = true;
+        }
+        wake.notify_all();
+        for(auto& worker : workers) worker.join();
+    }
+
+    inline void thread_pool::push(std::function<void()>&& task) {
+        const std::size_t index = current_worker.first == this
+            ? current_worker.second
+            : next_queue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+        // pending is increased before the task is published, so that it is never less than the number of queued tasks
+        // and a thief which pops the task does not decrease it below 0
+        {
+            std::lock_guard lock{ sleep_mtx };
+            ++pending;
+        }
+        {
+            std::lock_guard lock{ queues[index]->mtx };
+            queues[index]->tasks.push_back(std::move(task));
+        }
+        wake.notify_one();
+    }
+
+    inline std::optional<std::function<void()>> thread_pool::pop(const std::size_t index) {
+        if(pending.load() == 0) return std::nullopt;
+        {
+            auto& own = *queues[index];
+            std::lock_guard lock{ own.mtx };
+            if(!own.tasks.empty()) {
+                auto task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                --pending;
+                return task;
+            }
+        }
+        for(std::size_t i = 1; i < queues.size(); ++i) {
+            auto& victim = *queues[(index + i) % queues.size()];
+            std::lock_guard lock{ victim.mtx };
+            if(!victim.tasks.empty()) {
+                auto task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                --pending;
+                return task;
+            }
+        }
+        return std::nullopt;
+    }
+
+    inline void thread_pool::work(const std::size_t index) {
+        current_worker = { this, index };
+        while(true) {
+            if(auto task = pop(index)) {
+                (*task)();
+                continue;
+            }
+            std::unique_lock lock{ sleep_mtx };
+            wake.wait(lock, [this]{ return pending.load() != 0 || stopping; });
+            if(stopping && pending.load() == 0) break;
+        }
+    }
+
+    template<typename F>
+    requires std::invocable<F&>
+    inline std::future<std::invoke_result_t<F&>> thread_pool::submit(F&& func) {
+        // std::function needs a copyable callable
+        auto task = std::make_shared<std::packaged_task<std::invoke_result_t<F&>()>>(std::forward<F>(func));
+        auto future = task->get_future();
+        push([this, task]{
+            (*task)();
+            // the future is ready before sleep_mtx is locked, so that wait() does not miss it
+            std::lock_guard lock{ sleep_mtx };
+            if(waiters != 0) wake.notify_all();
+        });
+        return future;
+    }
+
+    inline bool thread_pool::run_pending_task() {
+        const std::size_t index = current_worker.first == this ? current_worker.second : 0;
+        if(auto task = pop(index)) {
+            (*task)();
+            return true;
+        }
+        return false;
+    }
+
+    template<typename T>
+    inline T thread_pool::wait(std::future<T>& future) {
+        const auto ready = [&future]{ return future.wait_for(std::chrono::seconds{ 0 }) == std::future_status::ready; };
+        while(!ready()) {
+            if(run_pending_task()) continue;
+            // tasks may be pushed later by the task of the future
+            std::unique_lock lock{ sleep_mtx };
+            ++waiters;
+            wake.wait(lock, [this, &ready]{ return pending.load() != 0 || ready(); });
+            --waiters;
+        }
+        return future.get();
+    }
+
+    inline std::size_t thread_pool::size() const noexcept {
+        return workers.size();
+    }
+    inline thread_pool& thread_pool::shared() {
+        static thread_pool pool{};
+        return pool;
+    }
+}
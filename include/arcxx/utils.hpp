@@ -15,6 +15,13 @@
 #include <unordered_map>
 #include <numeric>
 #include <stdexcept>
+#include <algorithm>
+#include <ranges>
+#include <span>
+#include <limits>
+#include <cstdint>
+#include <iosfwd>
+#include <memory_resource>
 
 #ifdef _MSC_VER
 #include <format>
@@ -30,9 +37,105 @@
  */
 
 namespace arcxx{
+    namespace pmr {
+        namespace detail {
+            inline thread_local std::pmr::memory_resource* scoped_resource = nullptr;
+        }
+        // resource of the innermost resource_scope of the calling thread, or std::pmr::get_default_resource()
+        [[nodiscard]] inline std::pmr::memory_resource* current_resource() noexcept {
+            return detail::scoped_resource != nullptr ? detail::scoped_resource : std::pmr::get_default_resource();
+        }
+
+        // Make the resource current on the calling thread while the scope is alive, e.g. a monotonic arena per request.
+        class resource_scope {
+        private:
+            std::pmr::memory_resource* previous;
+        public:
+            explicit resource_scope(std::pmr::memory_resource* resource) noexcept : previous(detail::scoped_resource) {
+                detail::scoped_resource = resource;
+            }
+            resource_scope(const resource_scope&) = delete;
+            resource_scope& operator=(const resource_scope&) = delete;
+            ~resource_scope() {
+                detail::scoped_resource = previous;
+            }
+        };
+
+        /*
+         * polymorphic_allocator whose default is current_resource() instead of the global default resource.
+         * Strings and containers which are default constructed or copied in a resource_scope allocate from its resource,
+         * so that values decoded by connectors use it without passing allocators.
+         */
+        template<typename T>
+        class allocator : public std::pmr::polymorphic_allocator<T> {
+        public:
+            allocator() noexcept : std::pmr::polymorphic_allocator<T>(current_resource()) {}
+            allocator(std::pmr::memory_resource* resource) noexcept : std::pmr::polymorphic_allocator<T>(resource) {}
+            template<typename U>
+            allocator(const allocator<U>& other) noexcept : std::pmr::polymorphic_allocator<T>(other.resource()) {}
+
+            allocator select_on_container_copy_construction() const noexcept {
+                return allocator{};
+            }
+        };
+    }
+
+    // ARCXX_USE_PMR makes strings and result containers allocate from pmr::current_resource().
+    #ifdef ARCXX_USE_PMR
+    using string = std::basic_string<char, std::char_traits<char>, pmr::allocator<char>>;
+    template<typename T>
+    using vector = std::vector<T, pmr::allocator<T>>;
+    template<typename Key, typename T>
+    using unordered_map = std::unordered_map<Key, T, std::hash<Key>, std::equal_to<Key>, pmr::allocator<std::pair<const Key, T>>>;
+    #else
     using string = std::string;
+    template<typename T>
+    using vector = std::vector<T>;
+    template<typename Key, typename T>
+    using unordered_map = std::unordered_map<Key, T>;
+    #endif
     using string_view = std::basic_string_view<typename arcxx::string::value_type>;
 
+    namespace pmr {
+        // Make the global default resource current while the scope is alive, for states which outlive resource_scopes (e.g. caches).
+        class global_scope : public resource_scope {
+        public:
+            global_scope() noexcept : resource_scope(nullptr) {}
+        };
+    }
+
+    namespace detail {
+        #ifdef ARCXX_USE_PMR
+        // Error message of a connector, which is copied with the global default resource since connectors outlive resource_scopes.
+        class persistent_message : public std::optional<arcxx::string> {
+        public:
+            persistent_message() noexcept = default;
+            persistent_message(std::nullopt_t) noexcept {}
+            persistent_message& operator=(std::nullopt_t) noexcept {
+                this->reset();
+                return *this;
+            }
+            persistent_message& operator=(const arcxx::string_view msg) {
+                this->emplace(msg, pmr::allocator<char>{ std::pmr::get_default_resource() });
+                return *this;
+            }
+            persistent_message& operator=(const char* msg) {
+                return *this = arcxx::string_view{ msg };
+            }
+            persistent_message& operator=(const arcxx::string& msg) {
+                return *this = arcxx::string_view{ msg };
+            }
+            persistent_message& operator=(const std::optional<arcxx::string>& msg) {
+                if(msg) return *this = arcxx::string_view{ msg.value() };
+                this->reset();
+                return *this;
+            }
+        };
+        #else
+        using persistent_message = std::optional<arcxx::string>;
+        #endif
+    }
+
     template <class T, class E>
     using expected = tl::expected<T, E>;
     template<typename E>
@@ -139,4 +242,85 @@ namespace arcxx{
     [[nodiscard]] consteval auto concat_strings(built_in_string_literal<Ns>... strings) noexcept {
         return (... + string_literal<Ns>{ strings });
     }
+
+    namespace detail {
+        template<typename T>
+        struct is_string_literal_impl : std::false_type {};
+        template<typename CharT, std::size_t N>
+        struct is_string_literal_impl<basic_string_literal<CharT, N>> : std::true_type {};
+
+        // Whether the string is computed at compile time
+        template<typename T>
+        concept is_string_literal = is_string_literal_impl<std::remove_cvref_t<T>>::value;
+
+        // Getter is an empty type whose operator() returns a string usable in constant expressions
+        template<typename Getter>
+        concept constant_string_getter = requires {
+            typename std::integral_constant<std::size_t, std::char_traits<typename arcxx::string::value_type>::length(Getter{}())>;
+        };
+    }
+
+    template<detail::constant_string_getter Getter>
+    [[nodiscard]] consteval auto to_string_literal(const Getter getter) noexcept {
+        constexpr std::size_t N = std::char_traits<typename arcxx::string::value_type>::length(Getter{}()) + 1;
+        return string_literal<N>{ getter(), std::make_index_sequence<N>{} };
+    }
+
+    /*
+     * SQL text rendered by query_relation.
+     * It refers to static storage (null terminated) when whole statement is rendered at compile time
+     * or cached in sql_cache, otherwise it owns the rendered string.
+     */
+    class sql_string {
+        std::variant<arcxx::string_view, arcxx::string> text;
+    public:
+        sql_string(arcxx::string&& str) noexcept : text(std::move(str)) {}
+        explicit sql_string(const arcxx::string_view static_str) noexcept : text(static_str) {}
+
+        [[nodiscard]] bool is_static() const noexcept {
+            return std::holds_alternative<arcxx::string_view>(text);
+        }
+        [[nodiscard]] const typename arcxx::string::value_type* data() const noexcept {
+            return is_static() ? std::get<arcxx::string_view>(text).data() : std::get<arcxx::string>(text).data();
+        }
+        [[nodiscard]] const typename arcxx::string::value_type* c_str() const noexcept {
+            return data();
+        }
+        [[nodiscard]] std::size_t size() const noexcept {
+            return is_static() ? std::get<arcxx::string_view>(text).size() : std::get<arcxx::string>(text).size();
+        }
+        [[nodiscard]] std::size_t length() const noexcept {
+            return size();
+        }
+        [[nodiscard]] bool empty() const noexcept {
+            return size() == 0;
+        }
+
+        operator arcxx::string_view() const noexcept {
+            return arcxx::string_view{ data(), size() };
+        }
+        operator arcxx::string() const& {
+            return arcxx::string{ data(), size() };
+        }
+        operator arcxx::string() && {
+            if(is_static()) return arcxx::string{ data(), size() };
+            return std::move(std::get<arcxx::string>(text));
+        }
+
+        friend bool operator==(const sql_string& a, const arcxx::string_view b) noexcept {
+            return static_cast<arcxx::string_view>(a) == b;
+        }
+        template<typename Traits>
+        friend std::basic_ostream<typename arcxx::string::value_type, Traits>& operator<<(std::basic_ostream<typename arcxx::string::value_type, Traits>& os, const sql_string& sql) {
+            return os << static_cast<arcxx::string_view>(sql);
+        }
+    };
+
+    // Buffer which SQL is rendered into. e.g. arcxx::string, std::pmr::string
+    template<typename T>
+    concept sql_output_buffer = requires(T& buff, const typename arcxx::string::value_type* str, const std::size_t n) {
+        buff.clear();
+        buff.reserve(n);
+        buff.append(str, n);
+    };
 }
\ No newline at end of file
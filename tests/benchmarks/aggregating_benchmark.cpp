@@ -0,0 +1,72 @@
+#include "user_model.hpp"
+#include <ranges>
+
+TEST_CASE("User model aggregating benchmark"){
+    namespace ranges = std::ranges;
+    namespace kernels = arcxx::column_kernels;
+
+    auto connection = arcxx::sqlite3::connector::open(":memory:", arcxx::sqlite3::options::create | arcxx::sqlite3::options::memory);
+    REQUIRE(!connection.has_error());
+    connection.create_table<User>();
+    {
+        std::vector<User> users(100000);
+        for(auto i : ranges::views::iota(0,100000)){
+            users[i].id = i;
+            if(i % 10 != 0) users[i].height = 150.0 + i % 50;
+        }
+        REQUIRE(connection.bulk_insert<User>(users).has_value());
+    }
+
+    BENCHMARK_ADVANCED("100000 rows sum, avg, max and min by queries bench")(Catch::Benchmark::Chronometer meter){
+        meter.measure([&connection]{
+            return User::sum<User::Height>().exec(connection).value().value()
+                + User::avg<User::Height>().exec(connection).value().value()
+                + User::max<User::Height>().exec(connection).value().value()
+                + User::min<User::Height>().exec(connection).value().value();
+        });
+    };
+
+    BENCHMARK_ADVANCED("100000 rows sum, avg, max and min by a columnar result bench")(Catch::Benchmark::Chronometer meter){
+        meter.measure([&connection]{
+            const auto result = User::pluck<User::Height>().exec_columnar(connection);
+            const auto& heights = result.value().get<0>();
+            return heights.sum().value() + heights.avg().value() + heights.max().value() + heights.min().value();
+        });
+    };
+
+    const auto columns = User::pluck<User::Height>().exec_columnar(connection).value();
+    const auto& heights = columns.get<0>();
+    const auto aggregate = [&heights]{
+        return heights.sum().value() + heights.avg().value() + heights.max().value() + heights.min().value();
+    };
+
+    BENCHMARK_ADVANCED("100000 values aggregation by scalar kernels bench")(Catch::Benchmark::Chronometer meter){
+        kernels::use(kernels::instruction_set::scalar);
+        meter.measure(aggregate);
+    };
+
+    BENCHMARK_ADVANCED("100000 values aggregation by detected SIMD kernels bench")(Catch::Benchmark::Chronometer meter){
+        kernels::use(kernels::detected());
+        meter.measure(aggregate);
+    };
+
+    BENCHMARK_ADVANCED("100000 rows histogram of 4 buckets by queries bench")(Catch::Benchmark::Chronometer meter){
+        meter.measure([&connection]{
+            return User::where(User::Height::cmp < 160.0).count().exec(connection).value()
+                + User::where(User::Height::cmp >= 160.0 && User::Height::cmp < 170.0).count().exec(connection).value()
+                + User::where(User::Height::cmp >= 170.0 && User::Height::cmp < 180.0).count().exec(connection).value()
+                + User::where(User::Height::cmp >= 180.0).count().exec(connection).value();
+        });
+    };
+
+    const std::vector<double> bounds{ 160.0, 170.0, 180.0 };
+    BENCHMARK_ADVANCED("100000 values histogram by scalar kernels bench")(Catch::Benchmark::Chronometer meter){
+        kernels::use(kernels::instruction_set::scalar);
+        meter.measure([&heights, &bounds]{ return heights.histogram(bounds); });
+    };
+
+    BENCHMARK_ADVANCED("100000 values histogram by detected SIMD kernels bench")(Catch::Benchmark::Chronometer meter){
+        kernels::use(kernels::detected());
+        meter.measure([&heights, &bounds]{ return heights.histogram(bounds); });
+    };
+}
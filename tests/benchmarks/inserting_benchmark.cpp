@@ -1,4 +1,5 @@
 #include "user_model.hpp"
+#include <filesystem>
 
 TEST_CASE("User model inserting benchmark"){
     // Benchmark
@@ -28,4 +29,127 @@ TEST_CASE("User model inserting benchmark"){
             return t;
         });
     };
-}
\ No newline at end of file
+
+    BENCHMARK_ADVANCED("10000 data multi-row inserting bench")(Catch::Benchmark::Chronometer meter){
+        using namespace arcxx;
+        namespace ranges = std::ranges;
+
+        const auto users = []{
+            std::vector<User> users(10000);
+            for(auto i : ranges::views::iota(0,10000)){
+                users[i].id = i;
+                users[i].name = std::string{ "user" } + std::to_string(i);
+                users[i].height = 170.0 + i;
+            }
+            return users;
+        }();
+
+        meter.measure([&users](){
+            return User::insert(users).to_sql<arcxx::sqlite3::connector>().length();
+        });
+    };
+}
+
+TEST_CASE("User model inserting execution benchmark"){
+    namespace ranges = std::ranges;
+
+    const auto users = []{
+        std::vector<User> users(10000);
+        for(auto i : ranges::views::iota(0,10000)){
+            users[i].id = i;
+            users[i].name = std::string{ "user" } + std::to_string(i);
+            users[i].height = 170.0 + i;
+        }
+        return users;
+    }();
+
+    auto connection = arcxx::sqlite3::connector::open(":memory:", arcxx::sqlite3::options::create | arcxx::sqlite3::options::memory);
+    REQUIRE(!connection.has_error());
+
+    BENCHMARK_ADVANCED("10000 data inserting execution bench")(Catch::Benchmark::Chronometer meter){
+        meter.measure([&connection, &users](){
+            connection.drop_table<User>();
+            connection.create_table<User>();
+            std::size_t t = 0; // Optimization prevention
+            connection.transaction([&connection, &users, &t]{
+                for(const auto& user : users) {
+                    t += User::insert(user).exec(connection).has_value();
+                }
+                return arcxx::transaction::commit;
+            });
+            return t;
+        });
+    };
+
+    BENCHMARK_ADVANCED("10000 data multi-row inserting execution bench")(Catch::Benchmark::Chronometer meter){
+        meter.measure([&connection, &users](){
+            connection.drop_table<User>();
+            connection.create_table<User>();
+            std::size_t t = 0; // Optimization prevention
+            connection.transaction([&connection, &users, &t]{
+                t += User::insert(users).exec(connection).value_or(0);
+                return arcxx::transaction::commit;
+            });
+            return t;
+        });
+    };
+
+    BENCHMARK_ADVANCED("10000 data bulk inserting execution bench")(Catch::Benchmark::Chronometer meter){
+        meter.measure([&connection, &users](){
+            connection.drop_table<User>();
+            connection.create_table<User>();
+            return connection.bulk_insert<User>(users).value_or(0);
+        });
+    };
+}
+
+TEST_CASE("User model bulk inserting file benchmark"){
+    namespace ranges = std::ranges;
+
+    const auto users = []{
+        std::vector<User> users(10000);
+        for(auto i : ranges::views::iota(0,10000)){
+            users[i].id = i;
+            users[i].name = std::string{ "user" } + std::to_string(i);
+            users[i].height = 170.0 + i;
+        }
+        return users;
+    }();
+
+    auto connection = arcxx::sqlite3::connector::open("bulk_inserting_benchmark.sqlite3", arcxx::sqlite3::options::create);
+    REQUIRE(!connection.has_error());
+
+    BENCHMARK_ADVANCED("10000 data inserting in a transaction bench")(Catch::Benchmark::Chronometer meter){
+        meter.measure([&connection, &users](){
+            connection.drop_table<User>();
+            connection.create_table<User>();
+            std::size_t t = 0; // Optimization prevention
+            connection.transaction([&connection, &users, &t]{
+                for(const auto& user : users) {
+                    t += User::insert(user).exec(connection).has_value();
+                }
+                return arcxx::transaction::commit;
+            });
+            return t;
+        });
+    };
+
+    BENCHMARK_ADVANCED("10000 data bulk inserting bench")(Catch::Benchmark::Chronometer meter){
+        meter.measure([&connection, &users](){
+            connection.drop_table<User>();
+            connection.create_table<User>();
+            return connection.bulk_insert<User>(users).value_or(0);
+        });
+    };
+
+    BENCHMARK_ADVANCED("10000 data bulk inserting without sync bench")(Catch::Benchmark::Chronometer meter){
+        meter.measure([&connection, &users](){
+            connection.drop_table<User>();
+            connection.create_table<User>();
+            return connection.bulk_insert<User>(users, { .journal_mode = "MEMORY", .synchronous = "OFF" }).value_or(0);
+        });
+    };
+
+    connection.close();
+    std::filesystem::remove("bulk_inserting_benchmark.sqlite3");
+}
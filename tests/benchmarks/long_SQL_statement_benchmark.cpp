@@ -1,4 +1,20 @@
 #include "user_model.hpp"
+#include <cstdlib>
+#include <new>
+
+// Counts heap allocations to check rendering into a warm buffer does not allocate
+static std::size_t allocation_count = 0;
+void* operator new(std::size_t size) {
+    ++allocation_count;
+    if(void* ptr = std::malloc(size)) return ptr;
+    throw std::bad_alloc{};
+}
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
 
 struct Clothes : public arcxx::model<Clothes> {
     inline static decltype(auto) table_name = "clothes_table";
@@ -71,4 +87,46 @@ TEST_CASE("Long SQL statement benchmark"){
             return t;
         });
     };
+
+    const auto query = Clothes::join<User>().where(
+        User::Name::like("user%") &&
+        User::Height::cmp < 175.0 &&
+        Clothes::Price::between(10'000,50'000) &&
+        Clothes::UpdateAt::between(
+            sys_days(2022y/April/1d) + 00s,
+            sys_days(2022y/April/last) + 23h + 59min + 59s
+        )
+    ).order_by<Clothes::Price>();
+    arcxx::string buff;
+    query.to_sql_into<arcxx::sqlite3::connector>(buff); // warm up
+    const auto warm_allocation_count = allocation_count;
+    for([[maybe_unused]]auto i : std::ranges::views::iota(0,100)){
+        query.to_sql_into<arcxx::sqlite3::connector>(buff);
+    }
+    CHECK(allocation_count == warm_allocation_count);
+
+    BENCHMARK_ADVANCED("Long SQL statement rendering into warm buffer bench")(Catch::Benchmark::Chronometer meter){
+        namespace ranges = std::ranges;
+
+        meter.measure([&query, &buff](){
+            std::size_t t = 0; // Optimization prevention
+            for([[maybe_unused]]auto i : ranges::views::iota(0,10000)){
+                query.to_sql_into<arcxx::sqlite3::connector>(buff);
+                t += buff.length();
+            }
+            return t;
+        });
+    };
+
+    BENCHMARK_ADVANCED("Long SQL statement cached rendering bench")(Catch::Benchmark::Chronometer meter){
+        namespace ranges = std::ranges;
+
+        meter.measure([&query](){
+            std::size_t t = 0; // Optimization prevention
+            for([[maybe_unused]]auto i : ranges::views::iota(0,10000)){
+                t += query.to_sql<arcxx::sqlite3::connector>().length();
+            }
+            return t;
+        });
+    };
 }
\ No newline at end of file
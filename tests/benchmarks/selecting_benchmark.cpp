@@ -0,0 +1,76 @@
+#include "user_model.hpp"
+#include <ranges>
+
+TEST_CASE("User model point lookup execution benchmark"){
+    namespace ranges = std::ranges;
+
+    auto connection = arcxx::sqlite3::connector::open(":memory:", arcxx::sqlite3::options::create | arcxx::sqlite3::options::memory);
+    REQUIRE(!connection.has_error());
+    connection.create_table<User>();
+    {
+        std::vector<User> users(1000);
+        for(auto i : ranges::views::iota(0,1000)){
+            users[i].id = i;
+            users[i].name = std::string{ "user" } + std::to_string(i);
+            users[i].height = 170.0 + i;
+        }
+        REQUIRE(User::insert(users).exec(connection).has_value());
+    }
+
+    const auto lookup = [&connection](){
+        std::size_t t = 0; // Optimization prevention
+        for(auto i : ranges::views::iota(std::size_t{ 0 }, std::size_t{ 1000 })) {
+            t += User::pluck<User::Name>().where(User::ID{i}).exec(connection).value().size();
+        }
+        return t;
+    };
+
+    BENCHMARK_ADVANCED("1000 point lookups with statement cache bench")(Catch::Benchmark::Chronometer meter){
+        connection.set_statement_cache_capacity(arcxx::sqlite3::connector::default_statement_cache_capacity);
+        meter.measure(lookup);
+    };
+
+    BENCHMARK_ADVANCED("1000 point lookups without statement cache bench")(Catch::Benchmark::Chronometer meter){
+        connection.set_statement_cache_capacity(0);
+        meter.measure(lookup);
+    };
+}
+
+TEST_CASE("User model scanning benchmark"){
+    namespace ranges = std::ranges;
+
+    auto connection = arcxx::sqlite3::connector::open(":memory:", arcxx::sqlite3::options::create | arcxx::sqlite3::options::memory);
+    REQUIRE(!connection.has_error());
+    connection.create_table<User>();
+    {
+        std::vector<User> users(10000);
+        for(auto i : ranges::views::iota(0,10000)){
+            users[i].id = i;
+            users[i].name = std::string{ "user" } + std::to_string(i);
+            users[i].height = 170.0 + i;
+        }
+        REQUIRE(User::insert(users).exec(connection).has_value());
+    }
+
+    BENCHMARK_ADVANCED("10000 rows filtering by decoded models bench")(Catch::Benchmark::Chronometer meter){
+        meter.measure([&connection]{
+            std::size_t t = 0; // Optimization prevention
+            auto executer = connection.make_executer(User::all());
+            for(const auto& row : executer.value()) {
+                if(row.value().get().name.value().ends_with('7')) ++t;
+            }
+            return t;
+        });
+    };
+
+    BENCHMARK_ADVANCED("10000 rows filtering by row views bench")(Catch::Benchmark::Chronometer meter){
+        meter.measure([&connection]{
+            std::size_t t = 0; // Optimization prevention
+            auto executer = connection.make_view_executer(User::all());
+            for(const auto& row : executer.value()) {
+                if(row.value().get().text(1).ends_with('7')) ++t;
+            }
+            return t;
+        });
+    };
+}
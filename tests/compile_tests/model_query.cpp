@@ -52,6 +52,10 @@ int main(){
     Test test;
     query_test(Test::insert(test));
     query_test(Test::insert(std::move(test)));
+    query_test(Test::insert(std::vector<Test>(3)));
+    query_test(Test::upsert(test));
+    query_test(Test::upsert(std::vector<Test>(3)).on_conflict<Test::Int>().update<Test::String>());
+    query_test(Test::update_each(std::vector<Test>(3)).set<Test::String, Test::Decimal>());
 
     query_test(Test::all());
     query_test(Test::select<Test::Int, Test::String, Test::Decimal, Test::DateTime, Test::Date>());
@@ -148,4 +152,34 @@ int main(){
 
     query_test(Test::max<Test::Date>());
     query_test(Test::min<Test::Date>());
+
+    // bind-free model queries are rendered at compile time
+    if(!Test::all().to_sql().is_static()) return 1;
+    if(!Test::count().to_sql().is_static()) return 1;
+    if(!Test::avg<Test::Int>().to_sql().is_static()) return 1;
+    if(!Have_a_Test::join<Test>().to_sql().is_static()) return 1;
+    if(Test::all().limit(1).to_sql().is_static()) return 1;
+
+    // multi-row insert repeats the group of values for each row
+    const Test row;
+    const auto multi_row_insert = Test::insert(std::vector<Test>(3, row));
+    if(multi_row_insert.rows.size() != 3) return 1;
+    arcxx::string multi_row_sql;
+    multi_row_insert.to_sql_into(multi_row_sql, 1, 1);
+    if(multi_row_sql != Test::insert(row).to_sql()) return 1;
+    if(multi_row_insert.to_sql().length() != multi_row_sql.length() + (multi_row_sql.length() - multi_row_sql.find(" VALUES ") - 8) * 2) return 1;
+    if(decltype(multi_row_insert)::rows_per_statement(12) != 2) return 1;
+    if(decltype(multi_row_insert)::rows_per_statement(3) != 1) return 1;
+
+    // upsert takes the conflict target from primary key and updates other columns by default
+    const auto upsert_sql = Test::upsert(row).to_sql();
+    if(!arcxx::string_view{ upsert_sql }.ends_with(R"( ON CONFLICT ("int_col") DO UPDATE SET "string_col" = excluded."string_col","decimal_col" = excluded."decimal_col","datetime_col" = excluded."datetime_col","date_col" = excluded."date_col";)")) return 1;
+    if(!arcxx::string_view{ Test::upsert(row).update<>().to_sql() }.ends_with(R"( ON CONFLICT ("int_col") DO NOTHING;)")) return 1;
+    if(!arcxx::string_view{ Test::upsert(row).on_conflict<Test::Int, Test::String>().update<Test::Decimal>().to_sql() }.ends_with(R"( ON CONFLICT ("int_col","string_col") DO UPDATE SET "decimal_col" = excluded."decimal_col";)")) return 1;
+
+    // update_each joins the rows by primary key
+    Test update_row;
+    update_row.int_col = 1;
+    update_row.str_col = "a";
+    if(Test::update_each(std::vector<Test>(1, update_row)).set<Test::String>().to_sql() != R"(WITH v("int_col","string_col") AS (VALUES (1,'a')) UPDATE "test_table" SET "string_col" = v."string_col" FROM v WHERE "test_table"."int_col" = v."int_col";)") return 1;
 }
\ No newline at end of file
@@ -147,4 +147,10 @@ int main(){
     query_test(Test::where(Test::Int::cmp > 0).avg<Test::Decimal>());
     query_test(Test::where(Test::Int::cmp > 0).max<Test::Decimal>());
     query_test(Test::where(Test::Int::cmp > 0).min<Test::Decimal>());
+
+    // relations of the same structure share the fingerprint regardless of bound values
+    if(Test::where(Test::Int::cmp == 1).fingerprint() != Test::where(Test::Int::cmp == 2).fingerprint()) return 1;
+    if(Test::where(Test::Int::cmp == 1).fingerprint() == Test::where(Test::Int::cmp != 1).fingerprint()) return 1;
+    if(query.where(Test::Int{0}).fingerprint() != query.where(Test::Int{1}).fingerprint()) return 1;
+    if(query.count().fingerprint() == query.fingerprint()) return 1;
 }
\ No newline at end of file
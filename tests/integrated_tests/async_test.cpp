@@ -0,0 +1,58 @@
+#include "user_model.hpp"
+
+#if defined(POSTGRESQL_TEST) && defined(ARCXX_POSTGRESQL_HAS_ASYNC)
+namespace {
+    arcxx::PostgreSQL::task<arcxx::expected<std::size_t, arcxx::string>> insert_and_count(connector& conn, const std::size_t id) {
+        User user;
+        user.id = id;
+        user.name = "user" + std::to_string(id);
+        if(auto inserted = co_await User::insert(user).exec_async(conn); !inserted) {
+            co_return arcxx::make_unexpected(inserted.error());
+        }
+        co_return co_await User::where(User::ID{id}).count().exec_async(conn);
+    }
+}
+
+TEST_CASE_METHOD(UserModelTestsFixture, "Async tests", "[connector][async][insert][select]") {
+    arcxx::PostgreSQL::reactor reactor;
+    if(reactor.has_error()) FAIL(reactor.error_message());
+
+    SECTION("Queries of connections are in flight at once"){
+        std::vector<connector> connections;
+        std::vector<arcxx::PostgreSQL::task<arcxx::expected<std::size_t, arcxx::string>>> tasks;
+        connections.reserve(30);
+        for(std::size_t i = 0; i < 30; ++i) {
+            connections.push_back(open_testfile());
+            tasks.push_back(insert_and_count(connections.back(), 10 + i));
+            reactor.spawn(tasks.back());
+        }
+        if(const auto result = reactor.run(); !result) FAIL(result.error());
+
+        for(auto& task : tasks) {
+            REQUIRE(task.done());
+            if(const auto& result = task.get(); !result) {
+                FAIL(result.error());
+            }
+            else {
+                REQUIRE(result.value() == 1);
+            }
+        }
+        REQUIRE(get_data_count() == 40);
+    }
+
+    SECTION("Errors are returned as results"){
+        auto task = [](connector& conn) -> arcxx::PostgreSQL::task<bool> {
+            User duplicated;
+            duplicated.id = 1;
+            const auto failed = co_await User::insert(duplicated).exec_async(conn);
+            // the connection executes queries after the error
+            const auto names = co_await User::pluck<User::Name>().where(User::ID{1}).exec_async(conn);
+            co_return !failed && names && names.value()[0] == arcxx::string{ "user1" };
+        }(conn);
+        reactor.spawn(task);
+        if(const auto result = reactor.run(); !result) FAIL(result.error());
+        REQUIRE(task.get());
+        REQUIRE(get_data_count() == 10);
+    }
+}
+#endif
@@ -0,0 +1,58 @@
+#include "user_model.hpp"
+
+#ifdef SQLITE_TEST
+TEST_CASE_METHOD(UserModelTestsFixture, "Bulk insert tests", "[connector][bulk_insert][insert]") {
+    std::vector<User> users(250);
+    for(std::size_t i = 0; i < users.size(); ++i) {
+        users[i].id = 10 + i;
+        users[i].name = "user" + std::to_string(10 + i);
+        users[i].height = 150.5 + static_cast<double>(i);
+    }
+
+    SECTION("Insert models in batched transactions"){
+        const arcxx::sqlite3::bulk_insert_options options{
+            .rows_per_transaction = 100,
+            .journal_mode = "MEMORY",
+            .synchronous = "OFF"
+        };
+        if(const auto result = conn.bulk_insert<User>(users, options); !result) {
+            FAIL(result.error());
+        }
+        else {
+            REQUIRE(result.value() == users.size());
+        }
+        REQUIRE(get_data_count() == 260);
+
+        if(const auto result = User::where(User::ID{259}).exec(conn); !result) {
+            FAIL(result.error());
+        }
+        else {
+            REQUIRE(result.value()[0].name == users.back().name);
+            REQUIRE(result.value()[0].height == users.back().height);
+        }
+        // modes are restored
+        REQUIRE(conn.pragma("journal_mode").value() == arcxx::string{ "delete" });
+        REQUIRE(conn.pragma("synchronous").value() == arcxx::string{ "2" });
+    }
+
+    SECTION("Committed transactions remain after an error"){
+        users[150].id = 1;
+        const auto result = conn.bulk_insert<User>(users, { .rows_per_transaction = 100 });
+        REQUIRE(!result);
+        REQUIRE(get_data_count() == 110);
+    }
+
+    SECTION("Rows are inserted in the outer transaction"){
+        users[150].id = 1;
+        const auto result = conn.transaction([&users](auto& connection){
+            namespace trans = arcxx::transaction;
+            if(const auto inserted = connection.template bulk_insert<User>(users, { .rows_per_transaction = 100 }); !inserted) {
+                return trans::rollback(inserted.error());
+            }
+            return trans::commit;
+        });
+        REQUIRE(!result);
+        REQUIRE(get_data_count() == 10);
+    }
+}
+#endif
@@ -0,0 +1,238 @@
+#include "user_model.hpp"
+
+TEST_CASE_METHOD(UserModelTestsFixture, "Columnar result tests", "[model][query_relation][select][columnar]") {
+    SECTION("Selected attributes are materialized into columns"){
+        const auto result = User::select<User::ID, User::Name, User::Height>().order_by<User::ID>().exec_columnar(conn);
+        if(!result) FAIL(result.error());
+        const auto& columns = result.value();
+        REQUIRE(columns.size() == 10);
+
+        const auto& ids = columns.get<User::ID>();
+        const auto& names = columns.get<1>();
+        const auto& heights = columns.get<User::Height>();
+        for(std::size_t i = 0; i < columns.size(); ++i) {
+            REQUIRE(ids[i] == i);
+            REQUIRE(names[i] == "user" + std::to_string(i));
+            REQUIRE(heights[i] == 170.0 + i);
+        }
+        REQUIRE(ids.values().size() == 10);
+        REQUIRE(heights.null_count() == 0);
+        REQUIRE(heights.null_bitmap().size() == 1);
+        REQUIRE(heights.null_bitmap()[0] == 0);
+    }
+
+    SECTION("NULL values are marked in the null bitmap"){
+        User user;
+        user.id = 10;
+        user.name = "null height";
+        REQUIRE(User::insert(user).exec(conn));
+
+        const auto result = User::pluck<User::Height>().order_by<User::ID>().exec_columnar(conn);
+        if(!result) FAIL(result.error());
+        const auto& heights = result.value().get<0>();
+        REQUIRE(heights.size() == 11);
+        REQUIRE(heights.null_count() == 1);
+        REQUIRE(heights.is_null(10));
+        REQUIRE(!heights.is_null(9));
+        REQUIRE(heights.null_bitmap()[0] == std::uint64_t{ 1 } << 10);
+    }
+
+    SECTION("All attributes of models are materialized"){
+        const auto result = User::all().exec_columnar(conn);
+        if(!result) FAIL(result.error());
+        const auto& columns = result.value();
+        REQUIRE(columns.column_count == 4);
+        REQUIRE(columns.size() == 10);
+        REQUIRE(columns.get<User::CreatedAt>().null_count() == 0);
+    }
+
+    #if defined(SQLITE_TEST)
+    SECTION("Values of other types are errors instead of NULL"){
+        // columns of sqlite3 may have values of any type
+        REQUIRE(arcxx::raw_query<void>("UPDATE user_table SET height = 'abc' WHERE id = 3;").exec(conn));
+        const auto heights = User::pluck<User::Height>().exec_columnar(conn);
+        REQUIRE(!heights);
+        REQUIRE(heights.error().find("height") != arcxx::string::npos);
+
+        // datetime stored as INTEGER without datetime_storage
+        const auto datetimes = arcxx::raw_query<std::vector<std::tuple<User::ID, User::CreatedAt>>>("SELECT 1 AS id, 946684800 AS created_at;").exec_columnar(conn);
+        REQUIRE(!datetimes);
+        REQUIRE(datetimes.error().find("created_at") != arcxx::string::npos);
+    }
+    #endif
+}
+
+TEST_CASE_METHOD(UserModelTestsFixture, "Columnar aggregation tests", "[model][select][aggregation][columnar]") {
+    namespace kernels = arcxx::column_kernels;
+    const auto isa = GENERATE(kernels::instruction_set::scalar, kernels::instruction_set::sse4_2, kernels::instruction_set::avx2);
+    kernels::use(isa);
+
+    SECTION("Aggregations are the same as the database"){
+        // rows over some 64 rows blocks, and some of heights are NULL
+        std::vector<User> users(200);
+        for(std::size_t i = 0; i < users.size(); ++i) {
+            users[i].id = 10 + i;
+            if(i % 7 != 0) users[i].height = 100.0 + static_cast<double>((i * 37) % 150);
+        }
+        REQUIRE(User::insert(users).exec(conn));
+
+        const auto result = User::select<User::ID, User::Height>().order_by<User::ID>().exec_columnar(conn);
+        if(!result) FAIL(result.error());
+        const auto& ids = result.value().get<User::ID>();
+        const auto& heights = result.value().get<User::Height>();
+
+        REQUIRE(ids.count() == User::count().exec(conn).value());
+        REQUIRE(ids.sum() == User::sum<User::ID>().exec(conn).value());
+        REQUIRE(ids.max() == User::max<User::ID>().exec(conn).value());
+        REQUIRE(ids.min() == User::min<User::ID>().exec(conn).value());
+        REQUIRE(heights.count() == 10 + 200 - 29);
+        REQUIRE(heights.sum() == User::sum<User::Height>().exec(conn).value());
+        REQUIRE(heights.avg().value() == User::avg<User::Height>().exec(conn).value());
+        REQUIRE(heights.max() == User::max<User::Height>().exec(conn).value());
+        REQUIRE(heights.min() == User::min<User::Height>().exec(conn).value());
+    }
+
+    SECTION("Aggregations of NULL only columns are empty"){
+        User user;
+        user.id = 10;
+        REQUIRE(User::insert(user).exec(conn));
+
+        const auto result = User::pluck<User::Height>().where(User::ID{ 10 }).exec_columnar(conn);
+        if(!result) FAIL(result.error());
+        const auto& heights = result.value().get<0>();
+        REQUIRE(heights.count() == 0);
+        REQUIRE(!heights.sum());
+        REQUIRE(!heights.avg());
+        REQUIRE(!heights.max());
+        REQUIRE(!heights.min());
+    }
+
+    kernels::use(kernels::detected());
+}
+
+TEST_CASE("Column kernels skip NaN", "[aggregation][columnar]") {
+    namespace kernels = arcxx::column_kernels;
+    const auto isa = GENERATE(kernels::instruction_set::scalar, kernels::instruction_set::sse4_2, kernels::instruction_set::avx2);
+
+    const auto min_max_of = [isa](const auto& values){
+        using value_type = typename std::remove_cvref_t<decltype(values)>::value_type;
+        auto [min_value, max_value] = kernels::min_max_identity<value_type>();
+        kernels::use(isa);
+        kernels::min_max(values.data(), values.size(), min_value, max_value);
+        kernels::use(kernels::detected());
+        return std::make_pair(min_value, max_value);
+    };
+
+    SECTION("NaN does not replace values of a lane"){
+        std::vector<double> doubles(64, 5.0);
+        doubles[0] = 1.0;
+        doubles[4] = std::numeric_limits<double>::quiet_NaN();
+        doubles[8] = 9.0;
+        REQUIRE(min_max_of(doubles) == std::make_pair(1.0, 9.0));
+
+        std::vector<float> floats(64, 5.0f);
+        floats[0] = 1.0f;
+        floats[8] = std::numeric_limits<float>::quiet_NaN();
+        floats[16] = 9.0f;
+        REQUIRE(min_max_of(floats) == std::make_pair(1.0f, 9.0f));
+    }
+
+    SECTION("NaN of the first values is skipped"){
+        std::vector<double> doubles(64, 5.0);
+        for(std::size_t i = 0; i < 8; ++i) doubles[i] = std::numeric_limits<double>::quiet_NaN();
+        doubles[20] = -3.0;
+        REQUIRE(min_max_of(doubles) == std::make_pair(-3.0, 5.0));
+    }
+
+    SECTION("Infinities are values"){
+        constexpr auto infinity = std::numeric_limits<double>::infinity();
+        REQUIRE(min_max_of(std::vector<double>(64, infinity)) == std::make_pair(infinity, infinity));
+        REQUIRE(min_max_of(std::vector<double>(3, -infinity)) == std::make_pair(-infinity, -infinity));
+
+        arcxx::column<User::Height> heights;
+        heights.push_back(infinity);
+        kernels::use(isa);
+        REQUIRE(heights.min() == infinity);
+        REQUIRE(heights.max() == infinity);
+        kernels::use(kernels::detected());
+    }
+
+    SECTION("Min and max of NaN only columns are NaN"){
+        arcxx::column<User::Height> heights;
+        for(int i = 0; i < 70; ++i) heights.push_back(std::numeric_limits<double>::quiet_NaN());
+        heights.push_null();
+        kernels::use(isa);
+        const auto [min_value, max_value] = heights.min_max();
+        kernels::use(kernels::detected());
+        REQUIRE(heights.count() == 70);
+        REQUIRE(std::isnan(min_value.value()));
+        REQUIRE(std::isnan(max_value.value()));
+    }
+}
+
+TEST_CASE("Column kernels count values into histogram buckets", "[aggregation][columnar]") {
+    namespace kernels = arcxx::column_kernels;
+    const auto isa = GENERATE(kernels::instruction_set::scalar, kernels::instruction_set::sse4_2, kernels::instruction_set::avx2);
+
+    const auto histogram_of = [isa]<typename T>(const std::vector<T>& values, const std::vector<T>& bounds){
+        std::vector<std::size_t> buckets(bounds.size() + 1, 0);
+        kernels::use(isa);
+        kernels::histogram(values.data(), values.size(), std::span<const T>{ bounds }, buckets.data());
+        kernels::use(kernels::detected());
+        return buckets;
+    };
+    // buckets counted by binary search
+    const auto expected_of = []<typename T>(const std::vector<T>& values, const std::vector<T>& bounds){
+        std::vector<std::size_t> buckets(bounds.size() + 1, 0);
+        for(const auto value : values) {
+            if(value != value) continue;
+            ++buckets[static_cast<std::size_t>(std::ranges::upper_bound(bounds, value) - bounds.begin())];
+        }
+        return buckets;
+    };
+
+    SECTION("Buckets of each type are the same as binary search"){
+        std::vector<std::int32_t> int32s;
+        std::vector<std::uint32_t> uint32s;
+        std::vector<std::int64_t> int64s;
+        std::vector<std::uint64_t> uint64s;
+        std::vector<double> doubles;
+        std::vector<float> floats;
+        // not a multiple of lanes, so that the rest is counted by scalar loops
+        for(int i = 0; i < 103; ++i) {
+            int32s.push_back(i * 7 % 50 - 25);
+            uint32s.push_back(static_cast<std::uint32_t>(i) * 0x0300'0000u);
+            int64s.push_back((i * 7 % 50 - 25) * 10'000'000'000LL);
+            uint64s.push_back(static_cast<std::uint64_t>(i) * 0x0300'0000'0000'0000ull);
+            doubles.push_back(i % 11 == 0 ? std::numeric_limits<double>::quiet_NaN() : (i * 7 % 50) * 0.5 - 12.5);
+            floats.push_back(i % 13 == 0 ? -std::numeric_limits<float>::infinity() : static_cast<float>(i * 7 % 50) * 0.5f);
+        }
+        const std::vector<std::int32_t> int32_bounds{ -10, 0, 0, 10 };
+        const std::vector<std::uint32_t> uint32_bounds{ 0x0100'0000u, 0x8000'0000u, 0xF000'0000u };
+        const std::vector<std::int64_t> int64_bounds{ -100'000'000'000LL, 0, 100'000'000'000LL };
+        const std::vector<std::uint64_t> uint64_bounds{ 0x1000'0000'0000'0000ull, 0x8000'0000'0000'0000ull };
+        const std::vector<double> double_bounds{ -5.0, 0.0, 5.0 };
+        const std::vector<float> float_bounds{ 0.0f, 10.0f, 20.0f };
+
+        REQUIRE(histogram_of(int32s, int32_bounds) == expected_of(int32s, int32_bounds));
+        REQUIRE(histogram_of(uint32s, uint32_bounds) == expected_of(uint32s, uint32_bounds));
+        REQUIRE(histogram_of(int64s, int64_bounds) == expected_of(int64s, int64_bounds));
+        REQUIRE(histogram_of(uint64s, uint64_bounds) == expected_of(uint64s, uint64_bounds));
+        REQUIRE(histogram_of(doubles, double_bounds) == expected_of(doubles, double_bounds));
+        REQUIRE(histogram_of(floats, float_bounds) == expected_of(floats, float_bounds));
+        REQUIRE(histogram_of(doubles, std::vector<double>{}) == std::vector<std::size_t>{ 93 });
+    }
+
+    SECTION("NULL rows are not counted"){
+        arcxx::column<User::Height> heights;
+        for(int i = 0; i < 100; ++i) {
+            if(i % 10 == 0) heights.push_null();
+            else heights.push_back(150.0 + i % 50);
+        }
+        const std::vector<double> bounds{ 0.0, 160.0, 180.0 };
+        kernels::use(isa);
+        const auto buckets = heights.histogram(bounds);
+        kernels::use(kernels::detected());
+        REQUIRE(buckets == std::vector<std::size_t>{ 0, 18, 36, 36 });
+    }
+}
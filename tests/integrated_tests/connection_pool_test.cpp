@@ -0,0 +1,89 @@
+#include "user_model.hpp"
+#include <atomic>
+#include <thread>
+
+TEST_CASE_METHOD(UserModelTestsFixture, "Connection pool tests", "[connector][connection_pool]") {
+    SECTION("Returned connections are reused"){
+        arcxx::connection_pool<connector> pool{ { .min_size = 1, .max_size = 2 }, []{ return open_testfile(); } };
+        REQUIRE(pool.size() == 1);
+        REQUIRE(pool.idle_size() == 1);
+
+        const connector* first = nullptr;
+        if(auto checked_out = pool.checkout(); !checked_out) {
+            FAIL(checked_out.error());
+        }
+        else {
+            auto& handle = checked_out.value();
+            first = &handle.get();
+            REQUIRE(pool.idle_size() == 0);
+            REQUIRE(User::count().exec(*handle).value() == 10);
+        }
+        REQUIRE(pool.idle_size() == 1);
+
+        auto handle = pool.checkout();
+        REQUIRE(handle);
+        REQUIRE(&handle.value().get() == first);
+        REQUIRE(pool.size() == 1);
+    }
+
+    SECTION("Checkout times out when all connections are checked out"){
+        arcxx::connection_pool<connector> pool{ { .max_size = 1, .lazy = true }, []{ return open_testfile(); } };
+        REQUIRE(pool.size() == 0);
+        auto handle = pool.checkout();
+        REQUIRE(handle);
+        REQUIRE(pool.size() == 1);
+        REQUIRE(!pool.checkout(std::chrono::milliseconds{ 10 }));
+
+        handle.value().release();
+        REQUIRE(pool.checkout(std::chrono::milliseconds{ 10 }));
+    }
+
+    SECTION("Open transactions are rolled back on return"){
+        arcxx::connection_pool<connector> pool{ { .max_size = 1 }, []{ return open_testfile(); } };
+        {
+            auto handle = pool.checkout();
+            REQUIRE(handle);
+            REQUIRE(handle.value()->begin());
+            User user;
+            user.id = 10;
+            REQUIRE(User::insert(user).exec(*handle.value()));
+            REQUIRE(handle.value()->in_transaction());
+        }
+        auto handle = pool.checkout();
+        REQUIRE(handle);
+        REQUIRE(!handle.value()->in_transaction());
+        REQUIRE(!handle.value()->has_error());
+        REQUIRE(get_data_count() == 10);
+    }
+
+    SECTION("Threads share connections"){
+        arcxx::connection_pool<connector> pool{ { .min_size = 2, .max_size = 3 }, []{ return open_testfile(); } };
+        std::atomic<std::size_t> succeeded = 0;
+        std::vector<std::thread> threads;
+        for(std::size_t i = 0; i < 8; ++i) {
+            threads.emplace_back([&pool, &succeeded]{
+                for(std::size_t j = 0; j < 20; ++j) {
+                    auto handle = pool.checkout();
+                    if(handle && User::count().exec(*handle.value()).value_or(0) == 10) ++succeeded;
+                }
+            });
+        }
+        for(auto& thread : threads) thread.join();
+        REQUIRE(succeeded == 160);
+        REQUIRE(pool.size() <= 3);
+    }
+
+    #if defined(POSTGRESQL_TEST)
+    SECTION("Parallel connections fail at connect_timeout"){
+        // non-routable address, whose packets are dropped
+        const auto started = std::chrono::steady_clock::now();
+        const auto connectors = connector::open_many(2, "host=10.255.255.1 dbname=test_db connect_timeout=2");
+        REQUIRE(std::chrono::steady_clock::now() - started < std::chrono::seconds{ 10 });
+        REQUIRE(connectors.size() == 2);
+        for(const auto& conn : connectors) {
+            REQUIRE(conn.has_error());
+            REQUIRE(!conn.connected());
+        }
+    }
+    #endif
+}
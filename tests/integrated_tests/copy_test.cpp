@@ -0,0 +1,89 @@
+#include "user_model.hpp"
+
+#ifdef POSTGRESQL_TEST
+TEST_CASE_METHOD(UserModelTestsFixture, "COPY tests", "[connector][copy][insert][select]") {
+    SECTION("Copy all columns of models"){
+        std::vector<User> users(100);
+        for(std::size_t i = 0; i < users.size(); ++i) {
+            users[i].id = 10 + i;
+            users[i].name = "user" + std::to_string(10 + i);
+            users[i].height = 150.5 + static_cast<double>(i);
+        }
+        users[0].height = std::nullopt;
+
+        if(const auto result = conn.copy_in<User>(users); !result) {
+            FAIL(result.error());
+        }
+        else {
+            REQUIRE(result.value() == users.size());
+        }
+        REQUIRE(get_data_count() == 110);
+
+        if(const auto result = User::where(User::ID{11}).exec(conn); !result) {
+            FAIL(result.error());
+        }
+        else {
+            REQUIRE(result.value()[0].name == users[1].name);
+            REQUIRE(result.value()[0].height == users[1].height);
+        }
+        if(const auto result = User::pluck<User::Height>().where(User::ID{10}).exec(conn); !result) {
+            FAIL(result.error());
+        }
+        else {
+            REQUIRE(!result.value()[0]);
+        }
+    }
+
+    SECTION("Copy specified columns"){
+        std::vector<User> users(2);
+        users[0].id = 10;
+        users[1].id = 11;
+
+        if(const auto result = conn.copy_in<User, User::ID>(users); !result) {
+            FAIL(result.error());
+        }
+        else {
+            REQUIRE(result.value() == 2);
+        }
+        // default value of name
+        if(const auto result = User::pluck<User::Name>().where(User::ID{11}).exec(conn); !result) {
+            FAIL(result.error());
+        }
+        else {
+            REQUIRE(result.value()[0] == arcxx::string{ "unknow" });
+        }
+    }
+
+    SECTION("Copy fails if a row violates a constraint"){
+        std::vector<User> users(2);
+        users[0].id = 10;
+        users[1].id = 1;
+
+        REQUIRE(!conn.copy_in<User, User::ID>(users));
+        // no row is copied
+        REQUIRE(get_data_count() == 10);
+    }
+
+    SECTION("Export rows into models"){
+        std::vector<User> users;
+        if(const auto result = conn.copy_out<User>(User::where(User::ID::cmp > 5).order_by<User::ID>(), std::back_inserter(users)); !result) {
+            FAIL(result.error());
+        }
+        else {
+            REQUIRE(result.value() == 4);
+        }
+        REQUIRE(users.size() == 4);
+        REQUIRE(users[0].id == 6);
+        REQUIRE(users[0].name == arcxx::string{ "user6" });
+        REQUIRE(users[0].height == 176.0);
+
+        std::size_t count = 0;
+        const auto result = conn.copy_out<User>(User::where(User::Name{"user1"}), [&count](const User& user){
+            REQUIRE(user.id == 1);
+            ++count;
+        });
+        REQUIRE(result);
+        REQUIRE(count == 1);
+    }
+}
+#endif
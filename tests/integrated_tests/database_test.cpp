@@ -0,0 +1,63 @@
+#include "user_model.hpp"
+#include <atomic>
+#include <thread>
+
+#ifdef SQLITE_TEST
+TEST_CASE("SQLite database tests", "[connector][database][insert][select]") {
+    {
+        arcxx::sqlite3::database db{ "database_test.sqlite3", { .readers = 3 } };
+        if(db.has_error()) FAIL(db.error_message());
+        if(const auto result = db.create_table<User>(); !result) FAIL(result.error());
+
+        SECTION("Writes go to the writer and selects to readers"){
+            User user;
+            user.id = 1;
+            user.name = "user1";
+            if(const auto result = User::insert(user).exec(db); !result) FAIL(result.error());
+            if(const auto result = User::count().exec(db); !result) {
+                FAIL(result.error());
+            }
+            else {
+                REQUIRE(result.value() == 1);
+            }
+
+            auto reader = db.reader();
+            REQUIRE(reader);
+            REQUIRE(reader.value()->pragma("journal_mode").value() == arcxx::string{ "wal" });
+            // readers are read-only
+            REQUIRE(!reader.value()->exec(User::insert(user)));
+        }
+
+        SECTION("Threads read while another thread writes"){
+            std::atomic<std::size_t> read = 0;
+            std::vector<std::thread> threads;
+            threads.emplace_back([&db]{
+                static_cast<void>(db.transaction([](auto& writer){
+                    for(std::size_t i = 0; i < 100; ++i) {
+                        User user;
+                        user.id = i;
+                        if(const auto result = User::insert(user).exec(writer); !result) {
+                            return arcxx::transaction::rollback(result.error());
+                        }
+                    }
+                    return arcxx::transaction::commit;
+                }));
+            });
+            for(std::size_t i = 0; i < 4; ++i) {
+                threads.emplace_back([&db, &read]{
+                    for(std::size_t j = 0; j < 50; ++j) {
+                        // rows of the transaction are seen all at once
+                        if(const auto count = User::count().exec(db); count && (count.value() == 0 || count.value() == 100)) ++read;
+                    }
+                });
+            }
+            for(auto& thread : threads) thread.join();
+            REQUIRE(read == 200);
+            REQUIRE(User::count().exec(db).value() == 100);
+        }
+    }
+    std::filesystem::remove("database_test.sqlite3");
+    std::filesystem::remove("database_test.sqlite3-wal");
+    std::filesystem::remove("database_test.sqlite3-shm");
+}
+#endif
@@ -0,0 +1,181 @@
+#include "test_fixtures.hpp"
+#include <thread>
+
+struct Event : public arcxx::model<Event> {
+    inline static decltype(auto) table_name = "event_table";
+
+    struct ID : public arcxx::attributes::integer<Event, ID, std::size_t> {
+        inline static decltype(auto) column_name = "id";
+        using integer<Event, ID, size_t>::integer;
+
+        inline static const auto constraints = primary_key;
+    } id;
+
+    struct StartedAt : public arcxx::attribute<Event, StartedAt, std::chrono::time_point<std::chrono::system_clock, std::chrono::milliseconds>> {
+        inline static decltype(auto) column_name = "started_at";
+        using arcxx::attribute<Event, StartedAt, std::chrono::time_point<std::chrono::system_clock, std::chrono::milliseconds>>::attribute;
+    } started_at;
+
+    struct Day : public arcxx::attributes::date<Event, Day> {
+        inline static decltype(auto) column_name = "day";
+        using date<Event, Day>::date;
+    } day;
+};
+
+// datetimes are stored as INTEGER in sqlite3
+struct EpochEvent : public arcxx::model<EpochEvent> {
+    inline static decltype(auto) table_name = "epoch_event_table";
+    inline static constexpr auto datetime_storage = arcxx::sqlite3::datetime_storage::unix_milliseconds;
+
+    struct ID : public arcxx::attributes::integer<EpochEvent, ID, std::size_t> {
+        inline static decltype(auto) column_name = "id";
+        using integer<EpochEvent, ID, size_t>::integer;
+
+        inline static const auto constraints = primary_key;
+    } id;
+
+    struct StartedAt : public arcxx::attribute<EpochEvent, StartedAt, std::chrono::time_point<std::chrono::system_clock, std::chrono::milliseconds>> {
+        inline static decltype(auto) column_name = "started_at";
+        using arcxx::attribute<EpochEvent, StartedAt, std::chrono::time_point<std::chrono::system_clock, std::chrono::milliseconds>>::attribute;
+    } started_at;
+
+    struct CreatedAt : public arcxx::attributes::datetime<EpochEvent, CreatedAt> {
+        inline static decltype(auto) column_name = "created_at";
+        using datetime<EpochEvent, CreatedAt>::datetime;
+
+        inline static constexpr auto datetime_storage = arcxx::sqlite3::datetime_storage::unix_seconds;
+    } created_at;
+};
+
+class EventModelTestsFixture {
+protected:
+    connector conn;
+public:
+    EventModelTestsFixture() : conn(open_testfile()) {
+        conn.drop_table<Event>();
+        conn.drop_table<EpochEvent>();
+        if(const auto result = conn.create_table<Event>(arcxx::abort_if_exists); !result) {
+            FAIL(result.error());
+        }
+        if(const auto result = conn.create_table<EpochEvent>(arcxx::abort_if_exists); !result) {
+            FAIL(result.error());
+        }
+    }
+    ~EventModelTestsFixture(){
+        conn.drop_table<Event>();
+        conn.drop_table<EpochEvent>();
+        close_testfile(conn);
+    }
+};
+
+TEST_CASE("Datetime text tests", "[datetime]") {
+    namespace chrono = std::chrono;
+    using milliseconds_datetime = chrono::time_point<chrono::system_clock, chrono::milliseconds>;
+
+    SECTION("Time points are written in ISO 8601"){
+        const auto to_text = [](const auto time_point){
+            arcxx::string buff;
+            arcxx::detail::append_datetime(buff, time_point);
+            return buff;
+        };
+        const auto day = chrono::sys_days{ chrono::year{ 1999 } / 12 / 31 };
+        REQUIRE(to_text(arcxx::system_datetime{ day + chrono::hours{ 23 } + chrono::seconds{ 59 } }) == "1999-12-31 23:00:59");
+        REQUIRE(to_text(arcxx::system_date{ day }) == "1999-12-31");
+        REQUIRE(to_text(milliseconds_datetime{ day + chrono::milliseconds{ 5 } }) == "1999-12-31 00:00:00.005");
+        REQUIRE(to_text(milliseconds_datetime{ day }) == "1999-12-31 00:00:00");
+        REQUIRE(to_text(arcxx::system_date{ chrono::sys_days{ chrono::year{ 1 } / 1 / 1 } }) == "0001-01-01");
+    }
+
+    SECTION("Text is parsed with fraction and offset"){
+        const auto parse = [](const arcxx::string_view str){
+            return arcxx::detail::parse_datetime<milliseconds_datetime>(str);
+        };
+        const auto day = chrono::sys_days{ chrono::year{ 2020 } / 1 / 2 };
+        REQUIRE(parse("2020-01-02") == milliseconds_datetime{ day });
+        REQUIRE(parse("2020-01-02 03:04:05") == milliseconds_datetime{ day + chrono::seconds{ 3 * 3600 + 4 * 60 + 5 } });
+        REQUIRE(parse("2020-01-02T03:04:05.1239Z") == milliseconds_datetime{ day + chrono::milliseconds{ 11045123 } });
+        REQUIRE(parse("2020-01-02 03:04:05+09") == milliseconds_datetime{ day - chrono::hours{ 6 } + chrono::seconds{ 4 * 60 + 5 } });
+        REQUIRE(arcxx::detail::parse_datetime<arcxx::system_date>("2020-01-02 23:59:59") == arcxx::system_date{ day });
+
+        REQUIRE(!parse("2020-02-30"));
+        REQUIRE(!parse("2020-01-02 3:04:05"));
+        REQUIRE(!parse("2020-01-02 03:04:05."));
+        REQUIRE(!parse("2020-01-02 03:04:05 junk"));
+        REQUIRE(!parse(""));
+    }
+
+    SECTION("Text is converted on threads concurrently"){
+        std::vector<std::thread> threads;
+        std::atomic<std::size_t> mismatches = 0;
+        for(int t = 0; t < 4; ++t) {
+            threads.emplace_back([t, &mismatches]{
+                for(int i = 0; i < 10000; ++i) {
+                    const milliseconds_datetime time_point{ chrono::milliseconds{ (t * 10000 + i) * 86'400'123LL } };
+                    arcxx::string buff;
+                    arcxx::detail::append_datetime(buff, time_point);
+                    if(arcxx::detail::parse_datetime<milliseconds_datetime>(buff) != time_point) ++mismatches;
+                }
+            });
+        }
+        for(auto& thread : threads) thread.join();
+        REQUIRE(mismatches == 0);
+    }
+}
+
+TEST_CASE_METHOD(EventModelTestsFixture, "Datetime column tests", "[model][query_relation][datetime]") {
+    namespace chrono = std::chrono;
+    const auto day = chrono::sys_days{ chrono::year{ 2001 } / 2 / 3 };
+
+    SECTION("Milliseconds and dates are stored"){
+        Event event;
+        event.id = 1;
+        event.started_at = Event::StartedAt::value_type{ day + chrono::hours{ 4 } + chrono::milliseconds{ 5678 } };
+        event.day = arcxx::system_date{ day };
+        if(const auto result = Event::insert(event).exec(conn); !result) FAIL(result.error());
+
+        const auto events = Event::all().exec(conn);
+        if(!events) FAIL(events.error());
+        REQUIRE(events.value().size() == 1);
+        REQUIRE(events.value()[0].started_at == event.started_at);
+        REQUIRE(events.value()[0].day == event.day);
+
+        const auto between = Event::where(Event::StartedAt::between(Event::StartedAt::value_type{ day }, Event::StartedAt::value_type{ day + chrono::hours{ 5 } })).exec(conn);
+        if(!between) FAIL(between.error());
+        REQUIRE(between.value().size() == 1);
+    }
+
+    SECTION("Datetimes are stored as integers since the Unix epoch"){
+        for(int i = 0; i < 3; ++i) {
+            EpochEvent event;
+            event.id = static_cast<std::size_t>(i);
+            event.started_at = EpochEvent::StartedAt::value_type{ day + chrono::hours{ i } + chrono::milliseconds{ 250 } };
+            event.created_at = arcxx::system_datetime{ day + chrono::hours{ i } };
+            if(const auto result = EpochEvent::insert(event).exec(conn); !result) FAIL(result.error());
+        }
+
+        const auto events = EpochEvent::all().order_by<EpochEvent::ID>().exec(conn);
+        if(!events) FAIL(events.error());
+        REQUIRE(events.value().size() == 3);
+        REQUIRE(events.value()[1].started_at == EpochEvent::StartedAt::value_type{ day + chrono::hours{ 1 } + chrono::milliseconds{ 250 } });
+        REQUIRE(events.value()[1].created_at == arcxx::system_datetime{ day + chrono::hours{ 1 } });
+
+        const auto between = EpochEvent::where(EpochEvent::CreatedAt::between(arcxx::system_datetime{ day }, arcxx::system_datetime{ day + chrono::hours{ 1 } })).exec(conn);
+        if(!between) FAIL(between.error());
+        REQUIRE(between.value().size() == 2);
+
+        const auto latest = EpochEvent::max<EpochEvent::StartedAt>().exec(conn);
+        if(!latest) FAIL(latest.error());
+        REQUIRE(latest.value() == EpochEvent::StartedAt::value_type{ day + chrono::hours{ 2 } + chrono::milliseconds{ 250 } });
+
+        #if defined(SQLITE_TEST)
+        auto executer = conn.make_view_executer(EpochEvent::select<EpochEvent::StartedAt, EpochEvent::CreatedAt>().where(EpochEvent::ID{ 0 }));
+        if(!executer) FAIL(executer.error());
+        for(const auto& row : executer.value()) {
+            if(!row) FAIL(row.error());
+            const auto& view = row.value().get();
+            REQUIRE(view.number<std::int64_t>(0) == chrono::duration_cast<chrono::milliseconds>(day.time_since_epoch()).count() + 250);
+            REQUIRE(view.number<std::int64_t>(1) == chrono::duration_cast<chrono::seconds>(day.time_since_epoch()).count());
+        }
+        #endif
+    }
+}
@@ -0,0 +1,56 @@
+#include "user_model.hpp"
+#include <atomic>
+#include <thread>
+
+TEST_CASE_METHOD(UserModelTestsFixture, "Parallel execution tests", "[connector][exec_all][select]") {
+    arcxx::connection_pool<connector> pool{ { .max_size = 4 }, []{ return open_testfile(); } };
+
+    SECTION("Results are returned in order of queries"){
+        arcxx::thread_pool executor{ 2 };
+        auto [count, names, user, failed] = arcxx::exec_all(
+            executor, pool,
+            User::count(),
+            User::pluck<User::Name>().where(User::ID::cmp < 3),
+            User::where(User::ID{5}),
+            arcxx::raw_query<int>("SELECT COUNT(*) FROM no_such_table;")
+        );
+        REQUIRE(count.value() == 10);
+        REQUIRE(names.value().size() == 3);
+        REQUIRE(user.value()[0].name == arcxx::string{ "user5" });
+        REQUIRE(!failed);
+        REQUIRE(pool.size() <= 4);
+    }
+
+    SECTION("Shared executor runs nested tasks"){
+        auto [sums] = arcxx::exec_all(pool, User::sum<User::Height>());
+        REQUIRE(sums.value() == 1745.0);
+
+        auto& executor = arcxx::thread_pool::shared();
+        std::vector<std::future<int>> futures;
+        for(int i = 0; i < 100; ++i) {
+            futures.push_back(executor.submit([&executor, i]{
+                auto nested = executor.submit([i]{ return i; });
+                return executor.wait(nested);
+            }));
+        }
+        int total = 0;
+        for(auto& future : futures) total += executor.wait(future);
+        REQUIRE(total == 4950);
+    }
+
+    SECTION("Tasks pushed by threads concurrently are run once"){
+        arcxx::thread_pool executor{ 4 };
+        std::atomic<int> runs = 0;
+        std::vector<std::thread> threads;
+        for(int t = 0; t < 4; ++t) {
+            threads.emplace_back([&executor, &runs]{
+                std::vector<std::future<void>> futures;
+                for(int i = 0; i < 2000; ++i) futures.push_back(executor.submit([&runs]{ ++runs; }));
+                for(auto& future : futures) executor.wait(future);
+            });
+        }
+        for(auto& thread : threads) thread.join();
+        REQUIRE(runs == 8000);
+        REQUIRE(!executor.run_pending_task());
+    }
+}
@@ -109,4 +109,34 @@ TEST_CASE_METHOD(UserModelTestsFixture, "Find query tests", "[model][query_relat
             }
         }
     }
+
+    SECTION("same structure queries share rendered SQL") {
+        const auto sql1 = User::where(User::ID::cmp == 1).to_sql<connector>();
+        const auto sql2 = User::where(User::ID::cmp == 2).to_sql<connector>();
+        REQUIRE(sql1.is_static());
+        REQUIRE(sql1.data() == sql2.data());
+
+        if (const auto find_users_result = User::where(User::ID::cmp == 2).exec(conn); !find_users_result) {
+            FAIL(find_users_result.error());
+        }
+        else {
+            REQUIRE(find_users_result.value().size() == 1);
+            REQUIRE(find_users_result.value()[0].id == 2);
+        }
+    }
+
+    SECTION("queries with literals are not cached") {
+        const auto cached_count = arcxx::sql_cache<connector>::size();
+        for(std::size_t i = 1; i <= 5; ++i) {
+            const auto sql = User::where(User::ID::cmp >= 0).limit(i).to_sql<connector>();
+            REQUIRE(!sql.is_static());
+            if (const auto find_users_result = User::where(User::ID::cmp >= 0).limit(i).exec(conn); !find_users_result) {
+                FAIL(find_users_result.error());
+            }
+            else {
+                REQUIRE(find_users_result.value().size() == i);
+            }
+        }
+        REQUIRE(arcxx::sql_cache<connector>::size() == cached_count);
+    }
 }
\ No newline at end of file
@@ -46,3 +46,76 @@ TEST_CASE("Insert query tests", "[model][query_relation][insert][select]") {
     connection.drop_table<User>();
     close_testfile(connection);
 }
+
+TEST_CASE("Multi-row insert query tests", "[model][query_relation][insert][select]") {
+    auto connection = open_testfile();
+
+    connection.drop_table<User>();
+    connection.create_table<User>();
+
+    SECTION("rows are inserted by one statement") {
+        std::vector<User> users(10);
+        for(std::size_t i = 0; i < users.size(); ++i){
+            users[i].id = i;
+            users[i].name = std::string{ "user" } + std::to_string(i);
+        }
+
+        const auto query = User::insert(users);
+        INFO(query.to_sql<connector>());
+        if(const auto result = query.exec(connection); !result){
+            FAIL(result.error());
+        }
+        else{
+            REQUIRE(result.value() == 10);
+        }
+
+        if(const auto total_result = User::sum<User::ID>().exec(connection); !total_result){
+            FAIL(total_result.error());
+        }
+        else{
+            REQUIRE(total_result.value() == 45);
+        }
+    }
+
+    SECTION("rows over the limit of bind variables are split into statements") {
+        using relation_t = decltype(User::insert(std::vector<User>{}));
+        const std::size_t row_count = relation_t::rows_per_statement(connection.bind_variable_limit()) + 10;
+
+        const auto insert_transaction = [row_count](auto& connection){
+            namespace transaction = arcxx::transaction;
+            auto users = std::views::iota(static_cast<std::size_t>(0), row_count) | std::views::transform([](const std::size_t i){
+                User user;
+                user.id = i;
+                user.name = "user";
+                return user;
+            });
+            if(const auto result = User::insert(users).exec(connection); !result){
+                return transaction::rollback(result.error());
+            }
+            else if(result.value() != row_count){
+                return transaction::rollback("unexpected number of inserted rows");
+            }
+            return transaction::commit;
+        };
+        if(const auto trans_result = connection.transaction(insert_transaction); !trans_result){
+            FAIL(trans_result.error());
+        }
+
+        if(const auto count_result = User::count().exec(connection); !count_result){
+            FAIL(count_result.error());
+        }
+        else{
+            REQUIRE(static_cast<std::size_t>(count_result.value()) == row_count);
+        }
+    }
+
+    SECTION("error of a statement is returned") {
+        std::vector<User> users(2);
+        users[0].id = 1;
+        users[1].id = 1;
+        REQUIRE(!User::insert(users).exec(connection));
+    }
+
+    connection.drop_table<User>();
+    close_testfile(connection);
+}
@@ -0,0 +1,77 @@
+#include "user_model.hpp"
+
+#ifdef POSTGRESQL_TEST
+TEST_CASE_METHOD(UserModelTestsFixture, "Pipeline tests", "[connector][pipeline][insert][select]") {
+    SECTION("Results are received in order"){
+        arcxx::PostgreSQL::pipeline pipeline{ conn };
+        if(pipeline.has_error()) FAIL(pipeline.error_message());
+
+        std::vector<arcxx::PostgreSQL::pipeline::future<void>> inserted;
+        for(std::size_t i = 10; i < 20; ++i) {
+            User user;
+            user.id = i;
+            user.name = "user" + std::to_string(i);
+            inserted.push_back(pipeline.push(User::insert(user)));
+        }
+        auto updated = pipeline.push(User::where(User::ID{1}).update(User::Name{"my user1"}));
+        auto names = pipeline.push(User::pluck<User::Name>().where(User::ID{1}));
+        auto count = pipeline.push(User::count());
+        REQUIRE(pipeline.pending_count() == 13);
+
+        for(auto& result : inserted) {
+            if(!result.get()) FAIL(result.get().error());
+        }
+        if(!updated.get()) FAIL(updated.get().error());
+        REQUIRE(!count.ready());
+        if(auto& result = names.get(); !result) {
+            FAIL(result.error());
+        }
+        else {
+            REQUIRE(result.value()[0] == arcxx::string{ "my user1" });
+        }
+
+        pipeline.receive();
+        REQUIRE(pipeline.pending_count() == 0);
+        REQUIRE(count.ready());
+        REQUIRE(count.get().value() == 20);
+    }
+
+    SECTION("An error does not abort other queries"){
+        User duplicated;
+        duplicated.id = 1;
+        User user;
+        user.id = 10;
+        {
+            arcxx::PostgreSQL::pipeline pipeline{ conn };
+            auto failed = pipeline.push(User::insert(duplicated));
+            auto invalid = pipeline.push(arcxx::raw_query<void>("INSERT INTO no_such_table VALUES (1);"));
+            auto succeeded = pipeline.push(User::insert(user));
+
+            REQUIRE(!failed.get());
+            REQUIRE(!invalid.get());
+            if(!succeeded.get()) FAIL(succeeded.get().error());
+        }
+        // the connection executes queries after the pipeline
+        REQUIRE(get_data_count() == 11);
+    }
+
+    SECTION("Evicted statements are deallocated even if a query fails"){
+        conn.set_statement_cache_capacity(1);
+        User duplicated;
+        duplicated.id = 1;
+        {
+            arcxx::PostgreSQL::pipeline pipeline{ conn };
+            auto found = pipeline.push(User::where(User::ID{1}));
+            // preparing the insert evicts the statement of the select
+            auto failed = pipeline.push(User::insert(duplicated));
+            REQUIRE(found.get());
+            REQUIRE(!failed.get());
+        }
+        // statements which are not cached remain on the server if they are not deallocated
+        conn.set_statement_cache_capacity(0);
+        const auto prepared = arcxx::raw_query<std::size_t>("SELECT COUNT(*) FROM pg_prepared_statements;").exec(conn);
+        if(!prepared) FAIL(prepared.error());
+        REQUIRE(prepared.value() == 0);
+    }
+}
+#endif
@@ -0,0 +1,81 @@
+#include "user_model.hpp"
+#include <memory_resource>
+
+// counts bytes allocated from the upstream resource
+class counting_resource : public std::pmr::memory_resource {
+public:
+    std::size_t allocated = 0;
+private:
+    void* do_allocate(const std::size_t bytes, const std::size_t alignment) override {
+        allocated += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* ptr, const std::size_t bytes, const std::size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+// model whose table is not created
+struct MissingModel : public arcxx::model<MissingModel> {
+    inline static decltype(auto) table_name = "missing_table";
+    struct ID : public arcxx::attributes::integer<MissingModel, ID, std::size_t> {
+        inline static decltype(auto) column_name = "id";
+        using integer<MissingModel, ID, size_t>::integer;
+    } id;
+};
+
+TEST_CASE_METHOD(UserModelTestsFixture, "Memory resource tests", "[model][query_relation][select][pmr]") {
+    SECTION("Results are allocated from the resource of the scope"){
+        std::pmr::monotonic_buffer_resource arena;
+        arcxx::pmr::resource_scope scope{ &arena };
+
+        const auto users = User::all().order_by<User::ID>().exec(conn);
+        if(!users) FAIL(users.error());
+        REQUIRE(users.value().size() == 10);
+        REQUIRE(users.value().get_allocator().resource() == &arena);
+        REQUIRE(users.value()[3].name.value() == "user3");
+        REQUIRE(users.value()[3].name.value().get_allocator().resource() == &arena);
+
+        const auto names = User::pluck<User::Name>().order_by<User::ID>().exec(conn);
+        if(!names) FAIL(names.error());
+        REQUIRE(names.value().get_allocator().resource() == &arena);
+        REQUIRE(names.value()[0].value() == "user0");
+    }
+
+    SECTION("Resources are restored at the end of scopes"){
+        counting_resource outer_resource;
+        std::pmr::monotonic_buffer_resource inner_resource;
+        {
+            arcxx::pmr::resource_scope outer{ &outer_resource };
+            {
+                arcxx::pmr::resource_scope inner{ &inner_resource };
+                REQUIRE(arcxx::pmr::current_resource() == &inner_resource);
+            }
+            REQUIRE(arcxx::pmr::current_resource() == &outer_resource);
+            const auto users = User::all().exec(conn);
+            if(!users) FAIL(users.error());
+            REQUIRE(outer_resource.allocated != 0);
+        }
+        REQUIRE(arcxx::pmr::current_resource() == std::pmr::get_default_resource());
+    }
+
+    SECTION("Connectors are usable after the resource of a scope is released"){
+        {
+            std::pmr::monotonic_buffer_resource arena;
+            arcxx::pmr::resource_scope scope{ &arena };
+            REQUIRE(User::where(User::ID{ 3 }).exec(conn));
+            // error message of the connector is not allocated from the arena
+            REQUIRE(!MissingModel::all().exec(conn));
+        }
+        REQUIRE(conn.has_error());
+        REQUIRE(!conn.error_message().empty());
+
+        const auto user = User::where(User::ID{ 3 }).exec(conn);
+        if(!user) FAIL(user.error());
+        REQUIRE(user.value().size() == 1);
+        REQUIRE(user.value()[0].name.value() == "user3");
+    }
+}
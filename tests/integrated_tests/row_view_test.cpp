@@ -0,0 +1,76 @@
+#include "user_model.hpp"
+
+TEST_CASE_METHOD(UserModelTestsFixture, "Row view tests", "[model][query_relation][select][row_view]") {
+    SECTION("Columns are read without decoding rows"){
+        auto executer = conn.make_view_executer(User::select<User::ID, User::Name, User::Height>().order_by<User::ID>());
+        if(!executer) FAIL(executer.error());
+        std::size_t expected_id = 0;
+        for(const auto& row : executer.value()) {
+            if(!row) FAIL(row.error());
+            const auto& view = row.value().get();
+            REQUIRE(view.size() == 3);
+            REQUIRE(view.name(1) == "name");
+            REQUIRE(view.number<std::size_t>(0) == expected_id);
+            REQUIRE(view.text(1) == "user" + std::to_string(expected_id));
+            REQUIRE(view.number<double>(2) == 170.0 + expected_id);
+            REQUIRE(!view.is_null(2));
+            ++expected_id;
+        }
+        REQUIRE(expected_id == 10);
+    }
+
+    SECTION("NULL columns are empty"){
+        User user;
+        user.id = 10;
+        user.name = "null height";
+        REQUIRE(User::insert(user).exec(conn));
+
+        auto executer = conn.make_view_executer(User::select<User::Height>().where(User::ID{ 10 }));
+        if(!executer) FAIL(executer.error());
+        std::size_t count = 0;
+        for(const auto& row : executer.value()) {
+            if(!row) FAIL(row.error());
+            const auto& view = row.value().get();
+            REQUIRE(view.is_null(0));
+            REQUIRE(view.text(0).empty());
+            REQUIRE(view.blob(0).empty());
+            REQUIRE(!view.number<double>(0));
+            ++count;
+        }
+        REQUIRE(count == 1);
+    }
+
+    SECTION("Statement is reusable after breaking iteration"){
+        for(std::size_t i = 0; i < 2; ++i) {
+            auto executer = conn.make_view_executer(User::select<User::Name>().order_by<User::ID>());
+            if(!executer) FAIL(executer.error());
+            for(const auto& row : executer.value()) {
+                if(!row) FAIL(row.error());
+                REQUIRE(row.value().get().text(0) == "user0");
+                break;
+            }
+        }
+        REQUIRE(get_data_count() == 10);
+    }
+
+    #if defined(POSTGRESQL_TEST)
+    SECTION("Rows of a result are accessed by index"){
+        auto result = conn.exec_view(User::select<User::ID, User::Name>().order_by<User::ID>());
+        if(!result) FAIL(result.error());
+        const auto& rows = result.value();
+        REQUIRE(rows.size() == 10);
+        REQUIRE(rows[9].text(1) == "user9");
+        REQUIRE(rows[3].number<int>(0) == 3);
+        std::size_t expected_id = 0;
+        for(const auto view : rows) {
+            REQUIRE(view.number<std::size_t>(0) == expected_id++);
+        }
+        REQUIRE(expected_id == 10);
+    }
+
+    SECTION("Errors of the query are returned by exec_view"){
+        auto result = conn.exec_view(arcxx::raw_query<std::vector<int>>("SELECT * FROM no_such_table"));
+        REQUIRE(!result);
+    }
+    #endif
+}
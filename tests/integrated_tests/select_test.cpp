@@ -24,4 +24,83 @@ TEST_CASE_METHOD(UserModelTestsFixture, "Select column query tests", "[model][qu
             REQUIRE(result.value()[0].value() == arcxx::string{ "user1" });
         }
     }
-}
\ No newline at end of file
+}
+#ifdef POSTGRESQL_TEST
+TEST_CASE_METHOD(UserModelTestsFixture, "Binary result format tests", "[model][query_relation][select][binary]") {
+    conn.set_binary_results(true);
+
+    SECTION("select all columns of user"){
+        if (const auto result = User::where(User::ID{1}).exec(conn); !result) {
+            FAIL(result.error());
+        }
+        else {
+            REQUIRE(result.value().size() == 1);
+            const auto& user = result.value()[0];
+            REQUIRE(user.id == std::size_t{ 1 });
+            REQUIRE(user.name == arcxx::string{ "user1" });
+            REQUIRE(user.height == 171.0);
+        }
+    }
+
+    SECTION("datetime is received as timestamp"){
+        User user;
+        user.id = 100;
+        user.created_at = arcxx::system_datetime{ std::chrono::sys_days{ std::chrono::year{ 1999 } / 12 / 31 } + std::chrono::hours{ 23 } + std::chrono::seconds{ 59 } };
+        if (const auto result = User::insert(user).exec(conn); !result) {
+            FAIL(result.error());
+        }
+        if (const auto result = User::pluck<User::CreatedAt>().where(User::ID{100}).exec(conn); !result) {
+            FAIL(result.error());
+        }
+        else {
+            REQUIRE(result.value()[0] == user.created_at);
+        }
+    }
+
+    SECTION("aggregation results"){
+        const auto count = User::count().exec(conn);
+        const auto sum = User::sum<User::ID>().exec(conn);
+        if (!count) FAIL(count.error());
+        if (!sum) FAIL(sum.error());
+        REQUIRE(count.value() == 10);
+        // sum of bigint is numeric
+        REQUIRE(sum.value() == std::size_t{ 45 });
+    }
+
+    SECTION("format is kept by moved connectors"){
+        connector configured = open_testfile();
+        configured.set_binary_results(true);
+        connector moved{ std::move(configured) };
+        REQUIRE(moved.binary_results());
+        auto result = moved.exec_view(User::select<User::ID>().where(User::ID{1}));
+        if(!result) FAIL(result.error());
+        // bigint is 8 bytes in binary format, and "1" in text format
+        REQUIRE(result.value()[0].text(0).size() == 8);
+        REQUIRE(result.value()[0].number<std::size_t>(0) == std::size_t{ 1 });
+        close_testfile(moved);
+    }
+}
+
+TEST_CASE_METHOD(UserModelTestsFixture, "Streaming executer tests", "[model][query_relation][select][streaming]") {
+    SECTION("Receive all users row by row"){
+        auto executer = conn.make_streaming_executer(User::order_by<User::ID>(), 1);
+        if(!executer) FAIL(executer.error());
+        std::size_t expected_id = 0;
+        for(const auto& row : executer.value()) {
+            if(!row) FAIL(row.error());
+            REQUIRE(row.value().get().id == expected_id++);
+        }
+        REQUIRE(expected_id == 10);
+    }
+
+    SECTION("Connection is available after breaking iteration"){
+        auto executer = conn.make_streaming_executer(User::pluck<User::Name>(), 4);
+        if(!executer) FAIL(executer.error());
+        for(const auto& row : executer.value()) {
+            if(!row) FAIL(row.error());
+            break;
+        }
+        REQUIRE(get_data_count() == 10);
+    }
+}
+#endif
@@ -0,0 +1,62 @@
+#include "user_model.hpp"
+
+TEST_CASE_METHOD(UserModelTestsFixture, "Prepared statement cache tests", "[connector][statement_cache][select]") {
+    const auto find_user1 = [this]{
+        const auto by_id = User::pluck<User::Name>().where(User::ID{1}).exec(conn);
+        const auto by_name = User::pluck<User::ID>().where(User::Name{"user1"}).exec(conn);
+        const auto by_height = User::pluck<User::ID>().where(User::Height{171.0}).exec(conn);
+        if(!by_id) FAIL(by_id.error());
+        if(!by_name) FAIL(by_name.error());
+        if(!by_height) FAIL(by_height.error());
+        REQUIRE(by_id.value()[0] == arcxx::string{ "user1" });
+        REQUIRE(by_name.value()[0] == std::size_t{ 1 });
+        REQUIRE(by_height.value()[0] == std::size_t{ 1 });
+    };
+
+    SECTION("Least recently used statements are evicted"){
+        conn.set_statement_cache_capacity(2);
+        REQUIRE(conn.statement_cache_size() <= 2);
+        find_user1();
+        // evicted statements are prepared again
+        find_user1();
+        REQUIRE(conn.statement_cache_size() == 2);
+    }
+
+    SECTION("Statements are not prepared without capacity"){
+        conn.set_statement_cache_capacity(0);
+        REQUIRE(conn.statement_cache_size() == 0);
+        find_user1();
+        REQUIRE(conn.statement_cache_size() == 0);
+    }
+
+#ifdef POSTGRESQL_TEST
+    SECTION("Statements are discarded on reconnect"){
+        find_user1();
+        REQUIRE(conn.statement_cache_size() > 0);
+        if(const auto result = conn.reconnect(); !result) {
+            FAIL(result.error());
+        }
+        REQUIRE(conn.statement_cache_size() == 0);
+        find_user1();
+    }
+#else
+    SECTION("Cached statements are reused"){
+        find_user1();
+        const auto hits = conn.statement_cache_hits();
+        const auto misses = conn.statement_cache_misses();
+        find_user1();
+        REQUIRE(conn.statement_cache_hits() == hits + 3);
+        REQUIRE(conn.statement_cache_misses() == misses);
+    }
+
+    SECTION("Statement borrowed by another executer is not shared"){
+        auto outer = conn.make_executer(User::where(User::ID{1}).select<User::Name>());
+        REQUIRE(outer);
+        for(const auto& outer_row : outer.value()) {
+            REQUIRE(outer_row);
+            find_user1();
+            REQUIRE(std::get<0>(outer_row.value().get()) == arcxx::string{ "user1" });
+        }
+    }
+#endif
+}
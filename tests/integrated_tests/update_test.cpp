@@ -14,4 +14,38 @@ TEST_CASE_METHOD(UserModelTestsFixture, "Update query tests", "[model][query_rel
             REQUIRE(result.value()[0] == arcxx::string{ "my user1" });
         }
     }
-}
\ No newline at end of file
+
+    SECTION("Update names and heights of each user"){
+        std::vector<User> users(3);
+        for(std::size_t i = 0; i < users.size(); ++i) {
+            users[i].id = i + 1;
+            users[i].name = "my user" + std::to_string(i + 1);
+            users[i].height = 150.0;
+        }
+        // not in the table
+        users.back().id = 100;
+
+        INFO((User::update_each(users).set<User::Name, User::Height>().to_sql<connector>()));
+        if (const auto result = User::update_each(users).set<User::Name, User::Height>().exec(conn); !result) {
+            FAIL(result.error());
+        }
+        else {
+            REQUIRE(result.value() == 2);
+        }
+
+        if (const auto result = User::select<User::Name, User::Height>().where(User::ID{2}).exec(conn); !result) {
+            FAIL(result.error());
+        }
+        else {
+            const auto& [name, height] = result.value()[0];
+            REQUIRE(name == arcxx::string{ "my user2" });
+            REQUIRE(height == 150.0);
+        }
+        if (const auto result = User::pluck<User::Name>().where(User::ID{3}).exec(conn); !result) {
+            FAIL(result.error());
+        }
+        else {
+            REQUIRE(result.value()[0] == arcxx::string{ "user3" });
+        }
+    }
+}
@@ -0,0 +1,68 @@
+#include "user_model.hpp"
+
+TEST_CASE_METHOD(UserModelTestsFixture, "Upsert query tests", "[model][query_relation][upsert][select]") {
+    SECTION("Update conflicting user and insert new user"){
+        std::vector<User> users(2);
+        users[0].id = 1;
+        users[0].name = "my user1";
+        users[1].id = 10;
+        users[1].name = "user10";
+
+        INFO(User::upsert(users).to_sql<connector>());
+        if (const auto result = User::upsert(users).exec(conn); !result) {
+            FAIL(result.error());
+        }
+        else {
+            REQUIRE(result.value() == 2);
+        }
+
+        REQUIRE(get_data_count() == 11);
+        if (const auto result = User::pluck<User::Name>().where(User::ID{1}).exec(conn); !result) {
+            FAIL(result.error());
+        }
+        else {
+            REQUIRE(result.value()[0] == arcxx::string{ "my user1" });
+        }
+    }
+
+    SECTION("Update only specified columns"){
+        User user;
+        user.id = 2;
+        user.name = "my user2";
+        user.height = 150.0;
+
+        INFO(User::upsert(user).update<User::Height>().to_sql<connector>());
+        if (const auto result = User::upsert(user).on_conflict<User::ID>().update<User::Height>().exec(conn); !result) {
+            FAIL(result.error());
+        }
+
+        if (const auto result = User::select<User::Name, User::Height>().where(User::ID{2}).exec(conn); !result) {
+            FAIL(result.error());
+        }
+        else {
+            const auto& [name, height] = result.value()[0];
+            REQUIRE(name == arcxx::string{ "user2" });
+            REQUIRE(height == 150.0);
+        }
+    }
+
+    SECTION("Conflicting user is not updated without update columns"){
+        User user;
+        user.id = 3;
+        user.name = "my user3";
+
+        if (const auto result = User::upsert(user).update<>().exec(conn); !result) {
+            FAIL(result.error());
+        }
+        else {
+            REQUIRE(result.value() == 0);
+        }
+
+        if (const auto result = User::pluck<User::Name>().where(User::ID{3}).exec(conn); !result) {
+            FAIL(result.error());
+        }
+        else {
+            REQUIRE(result.value()[0] == arcxx::string{ "user3" });
+        }
+    }
+}
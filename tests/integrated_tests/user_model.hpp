@@ -67,7 +67,7 @@ public:
             for(auto i = 0; i < 10; ++i){
                 User user;
                 user.id = i;
-                user.name = std::string{ "user" } + std::to_string(i);
+                user.name = arcxx::string{ "user" } + std::to_string(i).c_str();
                 user.height = 170.0 + i;
                 if(const auto result = User::insert(user).exec(connection); !result) {
                     WARN(result.error());